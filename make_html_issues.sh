@@ -24,7 +24,11 @@ fi
 
 rm -rf tmp/mailing
 mkdir -p tmp/mailing
-bin/lists tmp/
+# Start from the published pages, so that pages which have not changed are left alone.
+# Any page that is no longer made is removed by bin/lists.
+cp -p gh-pages/*.html tmp/mailing/
+# Keep the parsed issues between runs, so that only the issues that changed are parsed again
+bin/lists --write-if-changed --cache-dir .lwg-cache tmp/
 rm gh-pages/*.html
 mv tmp/mailing/* gh-pages/
 rm -r tmp
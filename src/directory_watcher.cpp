@@ -0,0 +1,98 @@
+#include "directory_watcher.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#if __has_include(<sys/inotify.h>)
+# include <poll.h>
+# include <sys/inotify.h>
+# include <unistd.h>
+# define LWG_HAVE_INOTIFY 1
+#endif
+
+namespace lwg
+{
+
+#if defined(LWG_HAVE_INOTIFY)
+
+directory_watcher::directory_watcher(std::vector<std::filesystem::path> const & directories)
+   : m_fd{inotify_init1(IN_CLOEXEC)}
+{
+   if (m_fd < 0) {
+      throw std::system_error{errno, std::generic_category(), "Cannot watch for changes"};
+   }
+   for (auto const & dir : directories) {
+      int wd = inotify_add_watch(m_fd, dir.c_str(), IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+      if (wd < 0) {
+         int err = errno;
+         close(m_fd);
+         throw std::system_error{err, std::generic_category(), "Cannot watch " + dir.string()};
+      }
+      m_directories[wd] = dir;
+   }
+}
+
+directory_watcher::~directory_watcher() {
+   close(m_fd);
+}
+
+auto directory_watcher::wait(std::chrono::milliseconds quiet) -> std::vector<std::filesystem::path> {
+   std::vector<std::filesystem::path> changed;
+
+   // Wait indefinitely for the first change, then for each change until it has been quiet.
+   for (int timeout = -1; ; timeout = static_cast<int>(quiet.count())) {
+      pollfd pfd{m_fd, POLLIN, 0};
+      int n = poll(&pfd, 1, timeout);
+      if (n < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         throw std::system_error{errno, std::generic_category(), "Cannot wait for changes"};
+      }
+      if (n == 0) {
+         return changed;
+      }
+
+      alignas(inotify_event) char buffer[4096];
+      auto len = read(m_fd, buffer, sizeof buffer);
+      if (len < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         throw std::system_error{errno, std::generic_category(), "Cannot read changes"};
+      }
+      for (char const * p = buffer; p < buffer + len; ) {
+         inotify_event event;
+         std::memcpy(&event, p, sizeof event);
+         if (event.len != 0) {
+            if (auto dir = m_directories.find(event.wd); dir != m_directories.end()) {
+               auto file = dir->second / std::string(p + sizeof event);
+               if (std::ranges::find(changed, file) == changed.end()) {
+                  changed.push_back(std::move(file));
+               }
+            }
+         }
+         p += sizeof event + event.len;
+      }
+   }
+}
+
+#else
+
+directory_watcher::directory_watcher(std::vector<std::filesystem::path> const &) {
+   throw std::runtime_error{"Watching for changes is not supported on this platform"};
+}
+
+directory_watcher::~directory_watcher() = default;
+
+auto directory_watcher::wait(std::chrono::milliseconds) -> std::vector<std::filesystem::path> {
+   return {};
+}
+
+#endif
+
+} // close namespace lwg
@@ -0,0 +1,38 @@
+#ifndef INCLUDE_LWG_DIRECTORY_WATCHER_H
+#define INCLUDE_LWG_DIRECTORY_WATCHER_H
+
+// standard headers
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <vector>
+
+namespace lwg
+{
+
+// Waits for files in some directories to change, e.g. for 'lists --watch'.
+// Changes are noticed from the time the watcher is constructed, even while the caller
+// is not waiting. Subdirectories are not watched.
+//
+// This uses inotify, so it is only available on Linux. Elsewhere the constructor throws.
+struct directory_watcher {
+   explicit directory_watcher(std::vector<std::filesystem::path> const & directories);
+   ~directory_watcher();
+
+   directory_watcher(directory_watcher const &) = delete;
+   directory_watcher & operator=(directory_watcher const &) = delete;
+
+   auto wait(std::chrono::milliseconds quiet) -> std::vector<std::filesystem::path>;
+      // Block until a file in one of the directories is written, created, renamed or removed,
+      // then until nothing else has changed for 'quiet', so that a save of several files, or an
+      // editor's write-and-rename, is seen as one change.
+      // Return every file that changed, once each, in the order they first changed.
+
+private:
+   int                                  m_fd = -1;
+   std::map<int, std::filesystem::path> m_directories;  // by inotify watch descriptor
+};
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_DIRECTORY_WATCHER_H
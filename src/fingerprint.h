@@ -0,0 +1,42 @@
+#ifndef INCLUDE_LWG_FINGERPRINT_H
+#define INCLUDE_LWG_FINGERPRINT_H
+
+// standard headers
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+
+namespace lwg
+{
+
+// Incrementally computes a 64-bit FNV-1a hash of a sequence of values.
+// This is used to detect changes to inputs, not for security.
+struct fingerprint {
+   auto add_bytes(std::string_view s) noexcept -> fingerprint & {
+      for (unsigned char c : s) {
+         m_value ^= c;
+         m_value *= 0x100000001b3;
+      }
+      return *this;
+   }
+
+   auto add(std::string_view s) noexcept -> fingerprint & {
+      // Include the length, so that "ab","c" differs from "a","bc".
+      add(s.size());
+      return add_bytes(s);
+   }
+
+   template<std::integral T>
+   auto add(T n) noexcept -> fingerprint & {
+      return add_bytes(std::string_view{reinterpret_cast<char const *>(&n), sizeof(n)});
+   }
+
+   auto value() const noexcept -> std::uint64_t { return m_value; }
+
+private:
+   std::uint64_t m_value = 0xcbf29ce484222325;
+};
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_FINGERPRINT_H
@@ -1,66 +1,186 @@
 #include "html_utils.h"
-#include <format>
 
 namespace lwg
 {
 constexpr std::string_view xml_whitespace = " \t\n\r";
+constexpr std::string_view xml_whitespace_or_gt = " \t\n\r>";
 
 inline bool is_whitespace(char c)
 {
   return xml_whitespace.find(c) != xml_whitespace.npos;
 }
 
-// Find the offset of the first <elem> in xml.
-std::string_view::size_type
-find_element(std::string_view elem, std::string_view xml)
+inline bool is_name_start(char c)
 {
-  if (elem.empty()) [[unlikely]]
-    return xml.npos;
+  // NameStartChar also includes many non-ASCII characters, so allow any of them.
+  return ('a' <= c and c <= 'z') or ('A' <= c and c <= 'Z') or c == '_' or c == ':'
+    or static_cast<unsigned char>(c) >= 0x80;
+}
 
-  std::string start_tag = std::format("<{}", elem);
-  std::string_view::size_type pos = 0;
-  while ((pos = xml.find(start_tag, pos)) != xml.npos)
-  {
-    if ((pos + start_tag.size()) == xml.size()) [[unlikely]]
-      return xml.npos;
+inline bool is_name_end(char c)
+{
+  return is_whitespace(c) or c == '/' or c == '>' or c == '=';
+}
 
-    if (char c = xml[pos + start_tag.size()]; c == '>' or is_whitespace(c) or c == '/')
-      return pos;
-    pos += start_tag.size();
-  }
-  return pos;
+std::string_view xml_token::attributes() const noexcept
+{
+  if (not is_start())
+    return {};
+  auto attrs = raw.substr(1 + name.size());
+  attrs.remove_suffix(kind == empty_element_tag ? 2 : 1);
+  return attrs;
 }
 
-// FIXME: This cannot handle "<p> <p>nested</p> </p>",
-// it returns up to the first "</p>" instead of the second.
-std::optional<xml_element>
-get_element(std::string_view elem, std::string_view xml)
+std::optional<std::string_view>
+xml_token::attribute(std::string_view attr) const noexcept
 {
-  auto pos = find_element(elem, xml); // Find "<elem"
+  auto attrs = attributes();
+  while (auto a = next_attribute(attrs))
+    if (a->name == attr)
+      return a->value;
+  return std::nullopt;
+}
 
-  if (pos == xml.npos) [[unlikely]]
+// Attribute ::= Name Eq AttValue
+// Eq ::= S? '=' S?
+std::optional<xml_attribute>
+next_attribute(std::string_view & attrs) noexcept
+{
+  auto pos = attrs.find_first_not_of(xml_whitespace);
+  if (pos == attrs.npos)
     return std::nullopt;
 
-  xml.remove_prefix(pos); // Remove everything before "<elem"
+  auto name_end = pos;
+  while (name_end != attrs.size() and not is_name_end(attrs[name_end]))
+    ++name_end;
+  if (name_end == pos) [[unlikely]]
+    return std::nullopt;
 
-  pos = xml.find('>');
-  if (pos == xml.npos) [[unlikely]]
+  auto eq = attrs.find_first_not_of(xml_whitespace, name_end);
+  if (eq == attrs.npos or attrs[eq] != '=') [[unlikely]]
     return std::nullopt;
 
-  // Check for self-closing tag, e.g. "<p/>"
+  auto open = attrs.find_first_not_of(xml_whitespace, eq + 1);
+  if (open == attrs.npos or (attrs[open] != '"' and attrs[open] != '\'')) [[unlikely]]
+    return std::nullopt;
+
+  auto close = attrs.find(attrs[open], open + 1);
+  if (close == attrs.npos) [[unlikely]]
+    return std::nullopt;
+
+  xml_attribute a{attrs.substr(pos, name_end - pos), attrs.substr(open + 1, close - open - 1)};
+  attrs.remove_prefix(close + 1);
+  return a;
+}
+
+xml_token xml_pull_parser::next() noexcept
+{
+  if (m_pos == m_xml.size())
+    return {};
+
+  auto rest = m_xml.substr(m_pos);
+
+  // Return the first n characters of rest as a token.
+  auto token = [&](xml_token::kind_type kind, std::string_view::size_type n, std::string_view name = {}) {
+    m_pos += n;
+    return xml_token{kind, rest.substr(0, n), name};
+  };
+
+  // Return everything up to the next '<' as text, even if that is not a tag.
+  auto text = [&] {
+    auto n = rest.find('<', 1);
+    return token(xml_token::text, n == rest.npos ? rest.size() : n);
+  };
+
+  // Return everything up to and including 'delim' as a token of kind 'other'.
+  auto other = [&](std::string_view delim) {
+    auto n = rest.find(delim);
+    return n == rest.npos ? text() : token(xml_token::other, n + delim.size());
+  };
+
+  if (rest[0] != '<' or rest.size() == 1)
+    return text();
+
+  if (rest.starts_with("<!--"))
+    return other("-->");
+  if (rest.starts_with("<![CDATA["))
+    return other("]]>");
+  if (rest.starts_with("<?"))
+    return other("?>");
+  if (rest.starts_with("<!"))
+    return other(">");
+
+  // ETag ::= '</' Name S? '>'
+  if (rest[1] == '/')
+  {
+    auto name_end = rest.find_first_of(xml_whitespace_or_gt, 2);
+    auto gt = rest.find_first_not_of(xml_whitespace, name_end);
+    if (name_end == 2 or gt == rest.npos or rest[gt] != '>')
+      return text();
+    return token(xml_token::end_tag, gt + 1, rest.substr(2, name_end - 2));
+  }
+
+  // STag ::= '<' Name (S Attribute)* S? '>'
   // EmptyElemTag ::= '<' Name (S Attribute)* S? '/>'
-  if (xml[pos - 1] == '/')
-    return xml_element{xml.substr(0, pos + 1), {}};
-
-  ++pos;
-  // N.B. we assume no whitespace in end tag, i.e. "</elem>" not "</elem >"
-  // although the XML spec does allow it: ETag ::= '</' Name S? '>'
-  std::string end_tag = std::format("</{}>", elem);
-  auto pos2 = xml.find(end_tag, pos);
-  if (pos2 == xml.npos) [[unlikely]]
+  if (not is_name_start(rest[1]))
+    return text();
+  auto name_end = std::string_view::size_type{1};
+  while (name_end != rest.size() and not is_name_end(rest[name_end]))
+    ++name_end;
+  if (name_end == rest.size())
+    return text();
+
+  // Find the closing '>', which may not be inside a quoted attribute value.
+  for (auto pos = name_end; pos < rest.size(); ++pos)
+  {
+    pos = rest.find_first_of("\"'>", pos);
+    if (pos == rest.npos)
+      break;
+    if (rest[pos] == '>')
+    {
+      auto kind = rest[pos - 1] == '/' ? xml_token::empty_element_tag : xml_token::start_tag;
+      return token(kind, pos + 1, rest.substr(1, name_end - 1));
+    }
+    pos = rest.find(rest[pos], pos + 1);
+    if (pos == rest.npos)
+      break;
+  }
+  return text();
+}
+
+std::optional<xml_element>
+xml_pull_parser::read_element(xml_token const & start) noexcept
+{
+  if (start.kind == xml_token::empty_element_tag)
+    return xml_element{start.raw, {}};
+
+  auto const content = m_pos;
+  int depth = 1;
+  for (auto tok = next(); tok.kind != xml_token::end_of_input; tok = next())
+  {
+    if (tok.kind == xml_token::start_tag and tok.name == start.name)
+      ++depth;
+    else if (tok.is_end(start.name) and --depth == 0)
+    {
+      auto first = start.raw.data() - m_xml.data();
+      auto inner_end = tok.raw.data() - m_xml.data();
+      return xml_element{m_xml.substr(first, m_pos - first), m_xml.substr(content, inner_end - content)};
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<xml_element>
+get_element(std::string_view elem, std::string_view xml)
+{
+  if (elem.empty()) [[unlikely]]
     return std::nullopt;
 
-  return xml_element{xml.substr(0, pos2 + end_tag.size()), xml.substr(pos, pos2 - pos)};
+  xml_pull_parser parser(xml);
+  for (auto tok = parser.next(); tok.kind != xml_token::end_of_input; tok = parser.next())
+    if (tok.is_start(elem))
+      return parser.read_element(tok);
+  return std::nullopt;
 }
 
 std::optional<std::string_view>
@@ -119,15 +239,11 @@ get_attribute(std::string_view attr, std::string_view xml)
 std::optional<std::string_view>
 get_attribute_of(std::string_view attr, std::string_view elem, std::string_view xml)
 {
-  std::string_view::size_type pos = 0;
-  while ((pos = find_element(elem, xml)) != xml.npos)
-  {
-    xml.remove_prefix(pos);
-    auto start_tag = xml.substr(0, xml.find('>', elem.size() + 1) + 1);
-    if (auto o = get_attribute(attr, start_tag))
-      return o;
-    xml.remove_prefix(start_tag.size());
-  }
+  xml_pull_parser parser(xml);
+  for (auto tok = parser.next(); tok.kind != xml_token::end_of_input; tok = parser.next())
+    if (tok.is_start(elem))
+      if (auto o = tok.attribute(attr))
+        return o;
   return std::nullopt;
 }
 
@@ -174,7 +290,7 @@ line = "ok"
   assert(lwg::get_element("elt", xml)->outer == "<elt attr=\"foo\" attr2=\"bar\" />");
   assert(lwg::get_element_content("elt", xml) == "");
   assert(lwg::get_element_content("p", xml) == "para <p/>another para");
-  // FIXME: assert(lwg::get_element_content("blockquote", xml) == "quote <blockquote>nested quote</blockquote>");
+  assert(lwg::get_element_content("blockquote", xml) == "quote <blockquote>nested quote</blockquote>");
   assert(lwg::get_attribute("attr", xml) == "foo");
   assert(lwg::get_attribute("attr3", xml) == "three");
   assert(lwg::get_attribute_of("attr3", "elt", xml) == "three");
@@ -194,5 +310,60 @@ line = "ok"
 
   assert(lwg::get_attribute_of("single", "quotes", xml) == "1");
   assert(lwg::get_attribute_of("double", "quotes", xml) == "2");
+
+  // The tokenizer reads each tag, and the text between them, in order:
+  {
+    using tok = lwg::xml_token;
+    lwg::xml_pull_parser p(R"(<?xml version="1.0"?><!-- <a> --><a x='1>2'>if a < b<b/>c &amp; d</a >)");
+    auto t = p.next();
+    assert(t.kind == tok::other and t.raw == R"(<?xml version="1.0"?>)");
+    t = p.next();
+    assert(t.kind == tok::other and t.raw == "<!-- <a> -->");
+    t = p.next();
+    assert(t.kind == tok::start_tag and t.name == "a" and t.attribute("x") == "1>2");
+    assert(t.attributes() == " x='1>2'");
+    t = p.next();
+    assert(t.kind == tok::text and t.raw == "if a ");
+    t = p.next();
+    assert(t.kind == tok::text and t.raw == "< b");
+    t = p.next();
+    assert(t.kind == tok::empty_element_tag and t.is_start("b") and t.attributes().empty());
+    t = p.next();
+    assert(t.kind == tok::text and t.raw == "c &amp; d");
+    t = p.next();
+    assert(t.is_end("a") and t.raw == "</a >");
+    assert(p.next().kind == tok::end_of_input);
+    assert(p.next().kind == tok::end_of_input);
+
+    std::string_view attrs = " one='1'\n two = \"2\"";
+    auto a = lwg::next_attribute(attrs);
+    assert(a and a->name == "one" and a->value == "1");
+    a = lwg::next_attribute(attrs);
+    assert(a and a->name == "two" and a->value == "2");
+    assert(not lwg::next_attribute(attrs));
+
+    // Unterminated markup is returned as text:
+    p = lwg::xml_pull_parser("<a x='>");
+    t = p.next();
+    assert(t.kind == tok::text and t.raw == "<a x='>");
+    p = lwg::xml_pull_parser("<!-- <a>");
+    assert(p.next().kind == tok::text);
+    assert(p.next().kind == tok::start_tag);
+
+    // read_element skips nested elements, and can be used to get each child in turn:
+    p = lwg::xml_pull_parser("<r><q>1<q>2</q></q><q/><q>3</q></r>");
+    assert(p.next().is_start("r"));
+    std::string children;
+    for (t = p.next(); not t.is_end("r"); t = p.next())
+    {
+      assert(t.is_start("q"));
+      auto e = p.read_element(t);
+      assert(e);
+      children += e->inner;
+      children += ';';
+    }
+    assert(children == "1<q>2</q>;;3;");
+    assert(p.remaining().empty());
+  }
 }
 #endif
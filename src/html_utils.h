@@ -1,3 +1,7 @@
+#ifndef INCLUDE_LWG_HTML_UTILS_H
+#define INCLUDE_LWG_HTML_UTILS_H
+
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <optional>
@@ -31,6 +35,90 @@ struct xml_element
   std::string_view inner; // just "content"
 };
 
+// A single token of XML, as read by xml_pull_parser.
+struct xml_token
+{
+  enum kind_type
+  {
+    end_of_input,
+    text,              // character data, which may be split over several tokens
+    start_tag,         // "<elem attr='value'>"
+    empty_element_tag, // "<elem attr='value'/>"
+    end_tag,           // "</elem>"
+    other              // comment, CDATA section, processing instruction or DOCTYPE
+  };
+
+  kind_type        kind = end_of_input;
+  std::string_view raw;  // the whole token, e.g. "<elem attr='value'>" or "some text"
+  std::string_view name; // the element name, for tags
+
+  // True for a start tag or empty-element tag.
+  [[nodiscard]]
+  bool is_start() const noexcept
+  { return kind == start_tag or kind == empty_element_tag; }
+
+  // True for a start tag or empty-element tag for elem.
+  [[nodiscard]]
+  bool is_start(std::string_view elem) const noexcept
+  { return is_start() and name == elem; }
+
+  // True for an end tag for elem.
+  [[nodiscard]]
+  bool is_end(std::string_view elem) const noexcept
+  { return kind == end_tag and name == elem; }
+
+  // The attribute list of a start tag or empty-element tag,
+  // e.g. " attr='value'" for "<elem attr='value'/>".
+  [[nodiscard]]
+  std::string_view attributes() const noexcept;
+
+  // Find attr="..." in a start tag or empty-element tag and return the attribute's value.
+  [[nodiscard]]
+  std::optional<std::string_view> attribute(std::string_view attr) const noexcept;
+};
+
+struct xml_attribute
+{
+  std::string_view name;
+  std::string_view value; // without the quotes
+};
+
+// Read the first attribute from an attribute list such as xml_token::attributes(),
+// and remove it from attrs. Returns nullopt when there are no more attributes.
+[[nodiscard]]
+std::optional<xml_attribute> next_attribute(std::string_view & attrs) noexcept;
+
+// Reads XML one token at a time, in a single pass and without allocating.
+// The tokens refer to the input, which must outlive them.
+// Malformed markup is not diagnosed, e.g. a '<' that does not start a tag
+// is returned as text, and end tags are not checked against start tags.
+struct xml_pull_parser
+{
+  explicit xml_pull_parser(std::string_view xml) noexcept
+  : m_xml(xml)
+  { }
+
+  // Read the next token, or return a token of kind end_of_input.
+  [[nodiscard]]
+  xml_token next() noexcept;
+
+  // Having just read the start tag start, read up to and including the
+  // matching end tag, allowing for nested elements with the same name.
+  // If start is an empty-element tag, the element has no content.
+  // Returns nullopt (and reads to the end) if there is no matching end tag.
+  [[nodiscard]]
+  std::optional<xml_element> read_element(xml_token const & start) noexcept;
+
+  // The input that has not been read yet.
+  [[nodiscard]]
+  std::string_view remaining() const noexcept
+  { return m_xml.substr(m_pos); }
+
+private:
+  std::string_view m_xml;
+  std::size_t      m_pos = 0;
+};
+
 // Find "<elem>...</elem>" in xml and return as two string views.
 [[nodiscard]]
 std::optional<xml_element> get_element(std::string_view elem, std::string_view xml);
@@ -54,3 +142,5 @@ struct issue;
 auto make_html_anchor(issue const & iss) -> std::string;
 
 }
+
+#endif // INCLUDE_LWG_HTML_UTILS_H
@@ -0,0 +1,170 @@
+#include "http_server.h"
+
+#include <cerrno>
+#include <exception>
+#include <format>
+#include <stdexcept>
+#include <system_error>
+
+#if __has_include(<sys/socket.h>)
+# include <arpa/inet.h>
+# include <netinet/in.h>
+# include <sys/socket.h>
+# include <sys/time.h>
+# include <unistd.h>
+# define LWG_HAVE_SOCKETS 1
+#endif
+
+namespace lwg
+{
+
+#if defined(LWG_HAVE_SOCKETS)
+
+namespace
+{
+constexpr std::size_t max_request_size = 64 * 1024;
+
+auto reason_phrase(int status) -> std::string_view {
+   switch (status) {
+      case 200: return "OK";
+      case 400: return "Bad Request";
+      case 404: return "Not Found";
+      case 405: return "Method Not Allowed";
+      case 431: return "Request Header Fields Too Large";
+      default:  return "Internal Server Error";
+   }
+}
+
+// Closes a socket when it goes out of scope.
+struct socket_handle {
+   int fd;
+   ~socket_handle() { if (fd >= 0) close(fd); }
+};
+
+// Read the request line and headers, ignoring any body, which GET and HEAD requests do not have.
+auto read_request(int fd, std::string & request) -> bool {
+   char buffer[4096];
+   while (request.find("\r\n\r\n") == request.npos) {
+      if (request.size() > max_request_size) {
+         return false;
+      }
+      auto n = recv(fd, buffer, sizeof buffer, 0);
+      if (n <= 0) {
+         return false;
+      }
+      request.append(buffer, n);
+   }
+   return true;
+}
+
+void send_all(int fd, std::string_view data) {
+   while (!data.empty()) {
+      auto n = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+      if (n < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         return;  // the client went away, there is no one to tell
+      }
+      data.remove_prefix(n);
+   }
+}
+
+void send_response(int fd, http_response const & response, bool head_only, std::string_view extra_headers = {}) {
+   auto header = std::format("HTTP/1.1 {} {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: close\r\n{}\r\n",
+                             response.status, reason_phrase(response.status), response.content_type,
+                             response.body.size(), extra_headers);
+   send_all(fd, header);
+   if (!head_only) {
+      send_all(fd, response.body);
+   }
+}
+
+auto error(int status, std::string message) -> http_response {
+   return {status, "text/plain; charset=utf-8", std::move(message) + '\n'};
+}
+
+void answer(int fd, http_handler const & handler) {
+   // A client that stops sending must not hold up everyone else.
+   timeval timeout{5, 0};
+   setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout);
+
+   std::string request;
+   if (!read_request(fd, request)) {
+      if (request.size() > max_request_size) {
+         send_response(fd, error(431, "Request too large"), false);
+      }
+      return;
+   }
+
+   // Request-line = method SP request-target SP HTTP-version CRLF
+   std::string_view line{request.data(), request.find("\r\n")};
+   auto const sp1 = line.find(' ');
+   auto const sp2 = line.rfind(' ');
+   if (sp1 == line.npos || sp2 == sp1 || !line.substr(sp2 + 1).starts_with("HTTP/1.")) {
+      send_response(fd, error(400, "Bad request"), false);
+      return;
+   }
+   auto const method = line.substr(0, sp1);
+   auto target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+   target = target.substr(0, target.find_first_of("?#"));
+
+   bool const head = method == "HEAD";
+   if (method != "GET" && !head) {
+      send_response(fd, error(405, "Only GET and HEAD are supported"), false, "Allow: GET, HEAD\r\n");
+      return;
+   }
+   if (!target.starts_with('/')) {
+      send_response(fd, error(400, "Bad request target"), head);
+      return;
+   }
+
+   try {
+      send_response(fd, handler(target), head);
+   }
+   catch (std::exception const & ex) {
+      send_response(fd, error(500, ex.what()), head);
+   }
+}
+} // close unnamed namespace
+
+void serve_http(std::uint16_t port, http_handler const & handler) {
+   socket_handle listener{socket(AF_INET, SOCK_STREAM, 0)};
+   if (listener.fd < 0) {
+      throw std::system_error{errno, std::generic_category(), "Cannot create socket"};
+   }
+   int const yes = 1;
+   setsockopt(listener.fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof yes);
+
+   sockaddr_in address{};
+   address.sin_family = AF_INET;
+   address.sin_port = htons(port);
+   address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   if (bind(listener.fd, reinterpret_cast<sockaddr const *>(&address), sizeof address) != 0
+       || listen(listener.fd, 16) != 0) {
+      throw std::system_error{errno, std::generic_category(), std::format("Cannot listen on port {}", port)};
+   }
+
+   for (;;) {
+      socket_handle client{accept(listener.fd, nullptr, nullptr)};
+      if (client.fd < 0) {
+         // A client that gave up before it was accepted does not stop the server,
+         // but any other error would only happen again, so retrying would spin.
+         if (errno == EINTR || errno == ECONNABORTED) {
+            continue;
+         }
+         throw std::system_error{errno, std::generic_category(), "Cannot accept a connection"};
+      }
+      answer(client.fd, handler);
+   }
+}
+
+#else
+
+void serve_http(std::uint16_t, http_handler const &) {
+   throw std::runtime_error{"Serving pages is not supported on this platform"};
+}
+
+#endif
+
+} // close namespace lwg
@@ -0,0 +1,33 @@
+#ifndef INCLUDE_LWG_HTTP_SERVER_H
+#define INCLUDE_LWG_HTTP_SERVER_H
+
+// standard headers
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace lwg
+{
+
+struct http_response {
+   int         status = 200;
+   std::string content_type = "text/html; charset=utf-8";
+   std::string body;
+};
+
+using http_handler = std::function<http_response(std::string_view path)>;
+   // Answers a request for 'path', e.g. "/lwg-active.html", without any query string.
+
+[[noreturn]] void serve_http(std::uint16_t port, http_handler const & handler);
+   // A minimal HTTP/1.1 server for previewing pages, e.g. for 'lists --serve'.
+   // It listens on the loopback interface only, answers one request at a time and closes each
+   // connection after answering it. Only GET and HEAD requests are passed to 'handler', and an
+   // exception thrown by it is answered with an error page.
+   // Throws std::system_error if 'port' cannot be listened on or a connection cannot be accepted,
+   // e.g. because the process has no file descriptors left, and std::runtime_error on platforms
+   // without BSD sockets.
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_HTTP_SERVER_H
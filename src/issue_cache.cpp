@@ -0,0 +1,214 @@
+#include "issue_cache.h"
+
+#include "fingerprint.h"
+#include "mapped_file.h"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+// Identifies the file format. Increment 'cache_version' whenever the layout
+// below, the members of lwg::issue, or the way issues are parsed changes,
+// so that caches written by older versions of the tools are discarded.
+constexpr char cache_magic[4] = { 'L', 'W', 'G', 'C' };
+constexpr std::uint32_t cache_version = 1;
+
+// Serialization of the fixed set of types that make up an lwg::issue.
+// The cache is only ever read on the machine that wrote it, so integers
+// are stored in native byte order.
+
+template<typename T>
+void put(std::string & out, T t) {
+   static_assert(std::is_trivially_copyable_v<T>);
+   out.append(reinterpret_cast<char const *>(&t), sizeof(t));
+}
+
+void put_string(std::string & out, std::string_view s) {
+   put<std::uint64_t>(out, s.size());
+   out += s;
+}
+
+struct reader {
+   std::string_view data;
+   bool ok = true;
+
+   template<typename T>
+   auto get() -> T {
+      T t{};
+      if (data.size() < sizeof(t)) {
+         ok = false;
+         return t;
+      }
+      std::memcpy(&t, data.data(), sizeof(t));
+      data.remove_prefix(sizeof(t));
+      return t;
+   }
+
+   auto get_string() -> std::string {
+      auto n = get<std::uint64_t>();
+      if (n > data.size()) {
+         ok = false;
+         return {};
+      }
+      std::string s{data.substr(0, n)};
+      data.remove_prefix(n);
+      return s;
+   }
+};
+
+void put_issue(std::string & out, lwg::issue const & is) {
+   put<std::int32_t>(out, is.num);
+   put_string(out, lwg::as_string(is.stat));
+   put_string(out, is.title);
+   put_string(out, is.doc_prefix);
+   put<std::uint64_t>(out, is.tags.size());
+   for (auto const & tag : is.tags) {
+      put_string(out, tag.prefix);
+      put_string(out, tag.name);
+   }
+   put_string(out, is.submitter);
+   put<std::int32_t>(out, int(is.date.year()));
+   put<std::uint32_t>(out, unsigned(is.date.month()));
+   put<std::uint32_t>(out, unsigned(is.date.day()));
+   put<std::uint64_t>(out, is.duplicates.size());
+   for (auto const & dup : is.duplicates) {
+      put_string(out, dup);
+   }
+   put_string(out, is.text);
+   put<std::int32_t>(out, is.priority);
+   put_string(out, is.owner);
+   put_string(out, is.resolution);
+   put<std::uint8_t>(out, is.has_resolution);
+}
+
+auto get_issue(reader & in) -> lwg::issue {
+   lwg::issue is;
+   is.num = in.get<std::int32_t>();
+   if (auto stat = lwg::find_status(in.get_string())) {
+      is.stat = *stat;
+   }
+   else {
+      in.ok = false;
+   }
+   is.title = in.get_string();
+   is.doc_prefix = in.get_string();
+   for (auto n = in.get<std::uint64_t>(); n != 0 && in.ok; --n) {
+      lwg::section_tag tag;
+      tag.prefix = in.get_string();
+      tag.name = in.get_string();
+      is.tags.push_back(std::move(tag));
+   }
+   is.submitter = in.get_string();
+   auto y = in.get<std::int32_t>();
+   auto m = in.get<std::uint32_t>();
+   auto d = in.get<std::uint32_t>();
+   is.date = lwg::chrono::year{y} / lwg::chrono::month{m} / lwg::chrono::day{d};
+   for (auto n = in.get<std::uint64_t>(); n != 0 && in.ok; --n) {
+      is.duplicates.insert(in.get_string());
+   }
+   is.text = in.get_string();
+   is.priority = in.get<std::int32_t>();
+   is.owner = in.get_string();
+   is.resolution = in.get_string();
+   is.has_resolution = in.get<std::uint8_t>();
+   return is;
+}
+
+} // close unnamed namespace
+
+namespace lwg
+{
+
+auto issue_cache::key(std::string_view file_contents) noexcept -> key_type {
+   return fingerprint{}.add_bytes(file_contents).value();
+}
+
+auto issue_cache::load(std::filesystem::path const & filename) -> issue_cache {
+   issue_cache cache;
+   std::error_code ec;
+   if (!std::filesystem::is_regular_file(filename, ec)) {
+      return cache;
+   }
+
+   mapped_file file{filename};
+   reader in{file.view()};
+   if (!in.data.starts_with(std::string_view{cache_magic, sizeof(cache_magic)})) {
+      return cache;
+   }
+   in.data.remove_prefix(sizeof(cache_magic));
+   if (in.get<std::uint32_t>() != cache_version) {
+      return cache;
+   }
+
+   for (auto n = in.get<std::uint64_t>(); n != 0 && in.ok; --n) {
+      auto name = in.get_string();
+      auto key = in.get<key_type>();
+      auto is = get_issue(in);
+      cache.m_entries.insert_or_assign(std::move(name), entry{key, std::move(is)});
+   }
+
+   if (!in.ok) {
+      // Truncated or corrupt, start again.
+      return issue_cache{};
+   }
+   return cache;
+}
+
+void issue_cache::save(std::filesystem::path const & filename) {
+   std::string out;
+   out.append(cache_magic, sizeof(cache_magic));
+   put<std::uint32_t>(out, cache_version);
+   put<std::uint64_t>(out, m_entries.size());
+   for (auto const & [name, e] : m_entries) {
+      put_string(out, name);
+      put<key_type>(out, e.key);
+      put_issue(out, e.is);
+   }
+
+   // Write to a temporary file first, so that an interrupted run cannot
+   // leave a truncated cache behind. Each run uses its own temporary file,
+   // so that runs saving the same cache at the same time cannot mix them up.
+   if (filename.has_parent_path()) {
+      std::filesystem::create_directories(filename.parent_path());
+   }
+   auto tmp = filename;
+   tmp += std::format(".{:08x}.tmp", std::random_device{}());
+   {
+      std::ofstream f{tmp, std::ios::binary};
+      if (!f.write(out.data(), out.size())) {
+         f.close();
+         std::error_code ec;
+         std::filesystem::remove(tmp, ec);
+         throw std::runtime_error{"Unable to write issue cache " + tmp.string()};
+      }
+   }
+   std::filesystem::rename(tmp, filename);
+   m_changed = false;
+}
+
+auto issue_cache::find(std::string const & filename, key_type key) const -> issue const * {
+   if (auto it = m_entries.find(filename); it != m_entries.end() && it->second.key == key) {
+      return &it->second.is;
+   }
+   return nullptr;
+}
+
+void issue_cache::insert(std::string const & filename, key_type key, issue const & is) {
+   m_entries.insert_or_assign(filename, entry{key, is});
+   m_changed = true;
+}
+
+void issue_cache::retain(std::span<std::string const> filenames) {
+   std::set<std::string_view> const keep(filenames.begin(), filenames.end());
+   if (std::erase_if(m_entries, [&](auto const & e) { return !keep.contains(e.first); })) {
+      m_changed = true;
+   }
+}
+
+} // close namespace lwg
@@ -0,0 +1,66 @@
+#ifndef INCLUDE_LWG_ISSUE_CACHE_H
+#define INCLUDE_LWG_ISSUE_CACHE_H
+
+// standard headers
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// solution specific headers
+#include "issues.h"
+
+namespace lwg
+{
+
+// A persistent cache of parsed issues, so that unchanged issue files do not
+// need to be parsed again on the next run.
+//
+// Each entry is keyed by the issue filename and a hash of the file contents.
+// The cached 'issue::mod_date' is not meaningful, because it depends on the
+// Git commit times and file modification times, so callers must set it again
+// using 'report_date_file_last_modified'. Nor are the 'issue::sections' ids stored,
+// because they depend on the section index, see 'assign_section_ids'.
+struct issue_cache {
+   using key_type = std::uint64_t;
+
+   static auto key(std::string_view file_contents) noexcept -> key_type;
+      // Return the content hash of an issue file.
+
+   static auto load(std::filesystem::path const & filename) -> issue_cache;
+      // Read the cache written by 'save'. Returns an empty cache if the file
+      // does not exist, or was written by an incompatible version of the tools.
+
+   void save(std::filesystem::path const & filename);
+      // Write the cache to 'filename', replacing it atomically, and creating its directory if needed.
+
+   auto find(std::string const & filename, key_type key) const -> issue const *;
+      // Return the cached issue for 'filename' if its contents still have the
+      // given 'key', otherwise null.
+
+   void insert(std::string const & filename, key_type key, issue const & is);
+      // Add or replace the cached issue for 'filename'.
+      // Unlike 'find', this must not be called concurrently.
+
+   void retain(std::span<std::string const> filenames);
+      // Remove the entries for any files not in 'filenames', e.g. after issues
+      // have been renumbered or deleted.
+
+   auto changed() const noexcept -> bool { return m_changed; }
+      // True if any entries have been inserted or removed since the cache was loaded or saved.
+
+private:
+   struct entry {
+      key_type key;
+      issue    is;
+   };
+
+   std::unordered_map<std::string, entry> m_entries;
+   bool m_changed = false;
+};
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_ISSUE_CACHE_H
@@ -0,0 +1,104 @@
+#include "issue_profile.h"
+
+#include <algorithm>
+#include <format>
+#include <ostream>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace lwg
+{
+
+namespace
+{
+auto milliseconds(issue_profile::duration d) -> double {
+   return std::chrono::duration<double, std::milli>(d).count();
+}
+
+auto microseconds(issue_profile::duration d) -> long long {
+   return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+// "1ms" rather than "1000us", to keep the histogram labels short.
+auto bucket_label(long long us) -> std::string {
+   if (us >= 1000000 && us % 1000000 == 0) return std::format("{}s", us / 1000000);
+   if (us >= 1000 && us % 1000 == 0) return std::format("{}ms", us / 1000);
+   return std::format("{}us", us);
+}
+} // close unnamed namespace
+
+void issue_profile::add_parse(int num, duration time, std::size_t input_bytes) {
+   std::lock_guard lock{m_mutex};
+   auto & c = m_issues[num];
+   c.parse += time;
+   c.input_bytes = input_bytes;
+}
+
+void issue_profile::add_format(int num, duration time) {
+   std::lock_guard lock{m_mutex};
+   m_issues[num].format += time;
+}
+
+void issue_profile::add_render(int num, duration time, std::size_t output_bytes) {
+   std::lock_guard lock{m_mutex};
+   auto & c = m_issues[num];
+   c.render += time;
+   c.output_bytes += output_bytes;
+}
+
+void issue_profile::print(std::ostream & out, std::size_t top) const {
+   std::vector<std::pair<int, cost>> issues;
+   {
+      std::lock_guard lock{m_mutex};
+      issues.assign(m_issues.begin(), m_issues.end());
+   }
+   if (issues.empty()) {
+      return;
+   }
+
+   // Slowest first, and by number when the times are the same
+   std::ranges::stable_sort(issues, std::ranges::greater{}, [](auto const & i) { return i.second.total(); });
+
+   duration total{};
+   for (auto const & [num, c] : issues) {
+      total += c.total();
+   }
+
+   out << std::format("Slowest {} of {} issues (mean {:.3f} ms):\n", std::min(top, issues.size()), issues.size(),
+                      milliseconds(total) / issues.size());
+   out << std::format("  {:>6}  {:>11}  {:>11}  {:>11}  {:>11}  {:>11}  {:>11}\n",
+                      "issue", "total (ms)", "parse (ms)", "format (ms)", "render (ms)", "in (bytes)", "out (bytes)");
+   for (auto const & [num, c] : issues | std::views::take(top)) {
+      out << std::format("  {:>6}  {:11.3f}  {:11.3f}  {:11.3f}  {:11.3f}  {:11}  {:11}\n",
+                         num, milliseconds(c.total()), milliseconds(c.parse), milliseconds(c.format),
+                         milliseconds(c.render), c.input_bytes, c.output_bytes);
+   }
+
+   // Buckets double in width, so that a long tail of slow issues stands out.
+   std::vector<std::size_t> buckets;
+   for (auto const & [num, c] : issues) {
+      std::size_t b = 0;
+      for (auto us = microseconds(c.total()); us > 1; us /= 2) {
+         ++b;
+      }
+      buckets.resize(std::max(buckets.size(), b + 1));
+      ++buckets[b];
+   }
+   auto const most = std::ranges::max(buckets);
+   constexpr std::size_t bar_width = 50;
+
+   out << "Time per issue:\n";
+   for (auto b = std::ranges::find_if(buckets, [](auto n) { return n != 0; }) - buckets.begin(); b != std::ssize(buckets); ++b) {
+      auto const label = b == 0 ? std::string{"< 2us"}
+                                : bucket_label(1ll << b) + " - " + bucket_label(1ll << (b + 1));
+      auto const bar = (buckets[b] * bar_width + most - 1) / most;
+      out << std::format("  {:>15}  {:7}", label, buckets[b]);
+      if (bar != 0) {
+         out << "  " << std::string(bar, '#');
+      }
+      out << '\n';
+   }
+}
+
+} // close namespace lwg
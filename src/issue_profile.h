@@ -0,0 +1,52 @@
+#ifndef INCLUDE_LWG_ISSUE_PROFILE_H
+#define INCLUDE_LWG_ISSUE_PROFILE_H
+
+// standard headers
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+
+namespace lwg
+{
+
+// The cost of each issue through the whole program, e.g. for 'lists --profile-issues',
+// to find issue files that take much longer than others of their size.
+// Costs may be added concurrently from any thread. Times are the CPU time of the thread that
+// worked on the issue (see 'thread_cpu_time'), so that time spent waiting for the CPU while other
+// threads run is not charged to whichever issue was being worked on.
+struct issue_profile {
+   using duration = std::chrono::nanoseconds;
+
+   void add_parse(int num, duration time, std::size_t input_bytes);
+      // Issue 'num' took 'time' to parse from a file of 'input_bytes'.
+
+   void add_format(int num, duration time);
+      // Issue 'num' took 'time' in 'format_issue_as_html'.
+
+   void add_render(int num, duration time, std::size_t output_bytes = 0);
+      // Issue 'num' took 'time' to render as HTML, producing 'output_bytes' of its own page.
+      // The times of every rendering of an issue are added together.
+
+   void print(std::ostream & out, std::size_t top) const;
+      // The 'top' issues that took longest in total, and a histogram of the total time of every issue.
+
+private:
+   struct cost {
+      duration    parse{};
+      duration    format{};
+      duration    render{};
+      std::size_t input_bytes = 0;
+      std::size_t output_bytes = 0;
+
+      auto total() const -> duration { return parse + format + render; }
+   };
+
+   mutable std::mutex   m_mutex;
+   std::map<int, cost>  m_issues;
+};
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_ISSUE_PROFILE_H
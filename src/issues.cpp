@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cassert>
 #include <istream>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <stdexcept>
@@ -61,7 +62,153 @@ auto parse_date(std::istream & temp) -> std::chrono::year_month_day {
 #endif
 }
 
-auto report_date_file_last_modified(std::filesystem::path const & filename, lwg::metadata const& meta) -> std::chrono::year_month_day {
+// Append 's' to 'out', replacing '<' and '>' and '&' with HTML character references.
+// This is used to turn backtick-quoted inline code into valid XML/HTML.
+void append_escaped(std::string & out, std::string_view s) {
+   for (char c : s) {
+      switch (c) {
+         case '&': out += "&amp;"; break;
+         case '<': out += "&lt;"; break;
+         case '>': out += "&gt;"; break;
+         default:  out += c;
+      }
+   }
+}
+
+// Inline `code` is replaced by this element.
+// This class attribute is used by the CSS in src/report_generator.cpp
+// so that the backticks are still displayed if this occurs inside a
+// <pre> element (because that always displays in code font anyway).
+constexpr std::string_view backtick_start = "<code class='backtick'>";
+constexpr std::string_view backtick_end = "</code>";
+
+// Append the contents of a ```code block``` to 'out', escaped.
+// Inline `code` is still recognized inside the block, and its contents
+// are escaped a second time.
+void append_code_block(std::string & out, std::string_view code) {
+   for (size_t p = 0; p < code.size(); ) {
+      size_t q = code.find('`', p);
+      append_escaped(out, code.substr(p, q - p));
+      if (q == code.npos)
+         break;
+      p = q;
+      if (p + 1 < code.size() and code[p+1] == '`') {
+         out += "``";
+         p += 2;
+         continue;
+      }
+      // The end of the block counts as the end of a line.
+      size_t p2 = code.find_first_of("`\n", p + 1);
+      if (p2 == code.npos or code[p2] == '\n') {
+         out += '`';
+         ++p;
+         continue;
+      }
+      std::string once;
+      append_escaped(once, code.substr(p + 1, p2 - p - 1));
+      out += backtick_start;
+      append_escaped(out, once);
+      out += backtick_end;
+      p = p2 + 1;
+   }
+}
+
+// Rewrite the markdown-style ```code blocks``` and inline `code` as valid XML,
+// and replace the obsolete <tt> element with <code>.
+// This is done in a single forward scan that appends to a new string, so
+// takes linear time however many replacements are made.
+std::string rewrite_markup(std::string_view tx, std::string const & filename) {
+   constexpr std::string_view fence = "\n```\n";
+
+   std::string out;
+   out.reserve(tx.size() + tx.size() / 8);
+
+   // An unreplaced "<tt" (e.g. "<ttx>") also prevents a match in the next two
+   // characters, as the old search-and-replace loop resumed after it.
+   size_t tt_from = 0;
+
+   for (size_t i = 0; ; ) {
+      // Text before the next ```code block```, or the end.
+      size_t block = tx.find(fence, i);
+      std::string_view text = tx.substr(0, block);
+
+      for (size_t p = i; p < text.size(); ) {
+         size_t q = text.find_first_of("`<", p);
+         out += text.substr(p, q - p);
+         if (q == text.npos)
+            break;
+         p = q;
+
+         if (tx[p] == '`') {
+            // Replace inline `code` with valid XML.
+            if (p + 1 < tx.size() and tx[p+1] == '`') {
+               // Some issues use double backtick for ``quotes like this''.
+               // We don't want to do anything here.
+               out += "``";
+               p += 2;
+               continue;
+            }
+            size_t p2 = tx.find_first_of("`\n", p + 1);
+            if (p2 != tx.npos and tx[p2] == '\n') {
+               // Do not treat "`foo\nbar`" as inline code.
+               // Move to the next backtick and check that one.
+               out += '`';
+               ++p;
+               continue;
+            }
+            // N.B. an unmatched backtick on the last line runs to the end.
+            out += backtick_start;
+            append_escaped(out, tx.substr(p + 1, p2 - p - 1));
+            out += backtick_end;
+            p = p2 == tx.npos ? tx.size() : p2 + 1;
+            continue;
+         }
+
+         // <tt> is obsolete in HTML5, replace with <code>:
+         std::string_view rest = tx.substr(p);
+         if (rest.starts_with("</tt>")) {
+            out += "</code>";
+            p += 5;
+            continue;
+         }
+         if (p >= tt_from and rest.starts_with("<tt")) {
+            if (rest.size() == 3)
+               throw lwg::bad_issue_file{filename, "Unexpected end of file after <tt"};
+            if (rest[3] == '>' || rest[3] == ' ') {
+               out += "<code";
+               p += 3;
+               continue;
+            }
+            tt_from = p + 5;
+         }
+         out += '<';
+         ++p;
+      }
+
+      if (block == tx.npos)
+         break;
+
+      // Replace ```code block``` with valid XML.
+      size_t block_end = tx.find(fence, block + 5);
+      if (block_end == tx.npos)
+         throw lwg::bad_issue_file{filename, "Unmatched ``` code block: " + std::string{tx.substr(block, 10)}};
+      out += "\n<pre><code>";
+      append_code_block(out, tx.substr(block + 5, block_end - block - 5));
+      out += "\n</code></pre>\n";
+      i = block_end + 5;
+   }
+
+   return out;
+}
+
+// True if 'rewrite_markup' would change the text.
+bool needs_rewriting(std::string_view tx) {
+   return tx.find('`') != tx.npos or tx.find("<tt") != tx.npos or tx.find("</tt>") != tx.npos;
+}
+
+} // close unnamed namespace
+
+auto lwg::report_date_file_last_modified(std::filesystem::path const & filename, lwg::metadata const& meta) -> std::chrono::year_month_day {
    using namespace std::chrono;
    system_clock::time_point t;
    // NB: Cannot use `native()` instead of `string()`, because on Windows that
@@ -86,78 +233,62 @@ auto report_date_file_last_modified(std::filesystem::path const & filename, lwg:
    return year_month_day(floor<days>(t));
 }
 
-// Replace '<' and '>' and '&' with HTML character references.
-// This is used to turn backtick-quoted inline code into valid XML/HTML.
-std::string escape_special_chars(std::string s) {
-   static const std::vector<std::pair<char, std::string_view>> subs {
-      { '&', "&amp;" }, // this has to come first!
-      { '<', "&lt;" },
-      { '>', "&gt;" },
-   };
-   for (auto [c, r] : subs)
-      for (auto p = s.find(c); p != s.npos; p = s.find(c, p+r.size()))
-         s.replace(p, 1, r);
-   return s;
-}
+auto lwg::parse_issue_from_file(std::string_view file_contents, std::string const & filename,
+  lwg::metadata const & meta) -> issue {
 
-} // close unnamed namespace
+   // Only copy the file contents if the markup needs to be rewritten,
+   // otherwise parse the original text directly.
+   std::string rewritten;
+   std::string_view tx = file_contents;
+   if (needs_rewriting(tx)) {
+      rewritten = rewrite_markup(tx, filename);
+      tx = rewritten;
+   }
 
-auto lwg::parse_issue_from_file(std::string tx, std::string const & filename,
-  lwg::metadata & meta) -> issue {
-   auto& section_db = meta.section_db;
-   struct bad_issue_file : std::runtime_error {
-      bad_issue_file(std::string const & filename, std::string error_message)
-         : runtime_error{"Error parsing issue file " + filename + ": " + error_message}
-         { }
-   };
+   issue is;
 
-   // Replace ```code block``` with valid XML.
-   for (size_t p = tx.find("\n```\n"); p != tx.npos; p = tx.find("\n```\n", p))
-   {
-      size_t p2 = tx.find("\n```\n", p + 5);
-      if (p2 == tx.npos)
-         throw bad_issue_file{filename, "Unmatched ``` code block: " + tx.substr(p, 10)};
-      auto code = "\n<pre><code>" + escape_special_chars(tx.substr(p + 5, p2 - p - 5)) + "\n</code></pre>\n";
-      tx.replace(p, p2 - p + 5, code);
-      p += code.size();
+   // Find every field in a single pass over the children of the <issue> element.
+   // Only the first of each element is used.
+   lwg::xml_pull_parser parser{tx};
+   lwg::xml_token issue_tag;
+   std::optional<std::string_view> title, sections_elem, submitter, date, priority, resolution;
+   std::string_view::size_type discussion = tx.npos;
+
+   for (auto tok = parser.next(); tok.kind != lwg::xml_token::end_of_input; tok = parser.next()) {
+      if (tok.is_start()) {
+         issue_tag = tok;
+         break;
+      }
    }
+   if (issue_tag.kind == lwg::xml_token::start_tag and issue_tag.name == "issue") {
+      auto set_once = [](std::optional<std::string_view> & field, std::string_view content) {
+         if (!field) {
+            field = content;
+         }
+      };
 
-   // Replace inline `code` with valid XML.
-   for (size_t p = tx.find('`'); p != tx.npos; p = tx.find('`', p))
-   {
-      if (tx[p+1] == '`')
-      {
-         // Some issues use double backtick for ``quotes like this''.
-         // We don't want to do anything here.
-         p += 2;
-         continue;
-      }
-      size_t p2 = tx.find('`', p + 1);
-      if (p2 > tx.find('\n', p + 1))
-      {
-         // Do not treat "`foo\nbar`" as inline code.
-         // Move to the next backtick and check that one.
-         p = p2;
-         continue;
+      for (auto tok = parser.next(); tok.kind != lwg::xml_token::end_of_input and !tok.is_end("issue"); tok = parser.next()) {
+         if (!tok.is_start()) {
+            continue;
+         }
+         if (tok.raw == "<discussion>" and discussion == tx.npos) {
+            discussion = tok.raw.data() - tx.data();
+         }
+         auto elem = parser.read_element(tok);
+         if (!elem) {
+            break;
+         }
+         if (tok.name == "title") set_once(title, elem->inner);
+         else if (tok.name == "section") set_once(sections_elem, elem->inner);
+         else if (tok.name == "submitter") set_once(submitter, elem->inner);
+         else if (tok.name == "date") set_once(date, elem->inner);
+         else if (tok.name == "priority") set_once(priority, elem->inner);
+         else if (tok.name == "resolution" and discussion != tx.npos) set_once(resolution, elem->inner);
       }
-      // This class attribute is used by the CSS in src/report_generator.cpp
-      // so that the backticks are still displayed if this occurs inside a
-      // <pre> element (because that always displays in code font anyway).
-      auto code = "<code class='backtick'>"
-         + escape_special_chars(tx.substr(p + 1, p2 - p - 1))
-         + "</code>";
-      tx.replace(p, p2 - p + 1, code);
-      p += code.size();
    }
-
-   // <tt> is obsolete in HTML5, replace with <code>:
-   for (auto p = tx.find("<tt"); p != tx.npos; p = tx.find("<tt", p+5))
-      if (tx.at(p+3) == '>' || tx.at(p+3) == ' ')
-         tx.replace(p, 3, "<code");
-   for (auto p = tx.find("</tt>"); p != tx.npos; p = tx.find("</tt>", p+7))
-         tx.replace(p, 5, "</code>");
-
-   issue is;
+   else {
+      issue_tag = {};
+   }
 
    auto get_or_throw = [&filename](const auto& opt, std::string_view what) {
       return opt ? *opt : throw bad_issue_file(filename, "Unable to find issue " + std::string(what));
@@ -165,11 +296,7 @@ auto lwg::parse_issue_from_file(std::string tx, std::string const & filename,
 
    // Get value from "<issue attr='value'>"
    auto get_attr = [&](std::string_view attr) {
-      return get_or_throw(lwg::get_attribute_of(attr, "issue", tx), attr);
-   };
-   // Get content from "<elem>content</elem>"
-   auto get_elem_content = [&](std::string_view elem) {
-      return get_or_throw(lwg::get_element_content(elem, tx), elem);
+      return get_or_throw(issue_tag.attribute(attr), attr);
    };
 
    // Get issue number
@@ -179,10 +306,16 @@ auto lwg::parse_issue_from_file(std::string tx, std::string const & filename,
    is.num = lwg::stoi(std::string(num));
 
    // Get issue status
-   is.stat = get_attr("status");
+   std::string_view stat = get_attr("status");
+   if (auto s = find_status(stat)) {
+      is.stat = *s;
+   }
+   else {
+      throw bad_issue_file{filename, "unknown status '" + std::string(stat) + "'"};
+   }
 
    // Get issue title
-   is.title = get_elem_content("title");
+   is.title = get_or_throw(title, "title");
 
    // Extract doc_prefix from title
    if (is.title[0] == '['
@@ -195,10 +328,12 @@ auto lwg::parse_issue_from_file(std::string tx, std::string const & filename,
    }
 
    // Get issue sections
-   std::string_view sections = get_elem_content("section");
-   while (auto sref = lwg::get_element("sref", sections))
+   lwg::xml_pull_parser sections{get_or_throw(sections_elem, "section")};
+   for (auto sref = sections.next(); sref.kind != lwg::xml_token::end_of_input; sref = sections.next())
    {
-      if (auto attr = lwg::get_attribute("ref", sref->outer))
+      if (!sref.is_start("sref"))
+         continue;
+      if (auto attr = sref.attribute("ref"))
       {
          if (attr->starts_with('[') and attr->ends_with(']'))
          {
@@ -212,16 +347,9 @@ auto lwg::parse_issue_from_file(std::string tx, std::string const & filename,
          tag.prefix = is.doc_prefix;
          tag.name = *attr;
          is.tags.emplace_back(tag);
-         if (section_db.find(is.tags.back()) == section_db.end()) {
-             section_num num{};
-             num.prefix = tag.prefix;
-             num.num.push_back(99);
-             section_db[is.tags.back()] = num;
-         }
       }
       else
          throw bad_issue_file{filename, "Missing ref attribute in <sref>"};
-      sections.remove_prefix(sref->outer.data() - sections.data() + sref->outer.size());
    }
 
    if (is.tags.empty()) {
@@ -229,10 +357,10 @@ auto lwg::parse_issue_from_file(std::string tx, std::string const & filename,
    }
 
    // Get submitter
-   is.submitter = get_elem_content("submitter");
+   is.submitter = get_or_throw(submitter, "submitter");
 
    // Get date
-   auto datestr = get_elem_content("date");
+   auto datestr = get_or_throw(date, "date");
 
    try {
 #ifdef __cpp_lib_sstream_from_string_view
@@ -250,18 +378,17 @@ auto lwg::parse_issue_from_file(std::string tx, std::string const & filename,
    is.mod_date = report_date_file_last_modified(filename, meta);
 
    // Get priority - this element is optional
-   if (auto o = lwg::get_element_content("priority", tx))
-      is.priority = lwg::stoi(std::string(*o));
+   if (priority)
+      is.priority = lwg::stoi(std::string(*priority));
 
    // Trim text to <discussion>
-   if (auto k = tx.find("<discussion>"); k != tx.npos)
-      tx.replace(0, k, "<issue>");
+   if (discussion != tx.npos)
+      tx.remove_prefix(discussion);
    else
       throw bad_issue_file{filename, "Unable to find issue discussion"};
 
    // Find out if issue has a proposed resolution
-   if (is_active(is.stat)  or  "Pending WP" == is.stat) {
-      auto resolution = lwg::get_element_content("resolution", tx);
+   if (is_active(is.stat)  or  status::pending_wp == is.stat) {
       // Ignore small amounts of whitespace between tags, with no actual resolution
       is.has_resolution = resolution.has_value() && resolution->length() >= 15;
 
@@ -276,6 +403,32 @@ auto lwg::parse_issue_from_file(std::string tx, std::string const & filename,
       is.has_resolution = true;
    }
 
-   is.text = std::move(tx);
+   is.text.reserve(tx.size() + 7);
+   is.text = "<issue>";
+   is.text += tx;
    return is;
 }
+
+void lwg::add_unknown_sections(issue const & is, section_map & section_db) {
+   for (auto const & tag : is.tags) {
+      if (section_db.find(tag) == section_db.end()) {
+         section_num num{};
+         num.prefix = tag.prefix;
+         num.num.push_back(99);
+         section_db[tag] = num;
+      }
+   }
+}
+
+void lwg::assign_section_ids(issue & is, section_registry const & sections) {
+   is.sections.clear();
+   is.sections.reserve(is.tags.size());
+   for (auto const & tag : is.tags) {
+      if (auto id = sections.find(tag)) {
+         is.sections.push_back(*id);
+      }
+      else {
+         throw std::runtime_error{"Unknown section [" + as_string(tag) + "] in issue " + std::to_string(is.num)};
+      }
+   }
+}
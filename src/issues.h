@@ -3,9 +3,13 @@
 
 // standard headers
 #include <chrono>
+#include <filesystem>
+#include <functional>
 #include <map>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // solution specific headers
@@ -18,10 +22,11 @@ namespace chrono = std::chrono;
 
 struct issue {
    int                        num;            // ID - issue number
-   std::string                stat;           // current status of the issue
+   status                     stat;           // current status of the issue
    std::string                title;          // descriptive title for the issue
    std::string                doc_prefix;     // extracted from title; e.g. filesys.ts
    std::vector<section_tag>   tags;           // section(s) of the standard affected by the issue
+   std::vector<section_id>    sections;       // the ids of 'tags' in the section_registry, see 'assign_section_ids'
    std::string                submitter;      // original submitter of the issue
    chrono::year_month_day     date;           // date the issue was filed
    chrono::year_month_day     mod_date;       // date the issue was last changed
@@ -33,15 +38,37 @@ struct issue {
    bool                       has_resolution; // 'true' if 'text' contains a proposed resolution
 };
 
-auto parse_issue_from_file(std::string file_contents, std::string const & filename, lwg::metadata & meta) -> issue;
+// A non-owning handle to an issue, for subsets and orderings of the issues
+// that must not copy or move the issues themselves.
+using issue_ref = std::reference_wrapper<issue const>;
+
+struct bad_issue_file : std::runtime_error {
+   bad_issue_file(std::string const & filename, std::string const & error_message)
+      : runtime_error{"Error parsing issue file " + filename + ": " + error_message}
+      { }
+};
+
+auto parse_issue_from_file(std::string_view file_contents, std::string const & filename, lwg::metadata const & meta) -> issue;
   // Seems appropriate constructor behavior.
   //
-  // Note that 'section_db' is modifiable as new (unknown) sections may be inserted,
-  // typically for issues reported against older documents with sections that have
-  // since been removed, replaced or merged.
+  // Does not modify 'meta', so may be called concurrently for different files.
   //
   // The filename is passed only to improve diagnostics.
 
+auto report_date_file_last_modified(std::filesystem::path const & filename, lwg::metadata const & meta) -> chrono::year_month_day;
+  // The date the issue in 'filename' was last changed: the Git commit date
+  // recorded in 'meta' if there is one, otherwise the file's modification time.
+
+void add_unknown_sections(issue const & is, section_map & section_db);
+  // Insert a placeholder entry into 'section_db' for each section of 'is' that
+  // is not already present, typically for issues reported against older documents
+  // with sections that have since been removed, replaced or merged.
+  // Must be called for every parsed issue before 'section_db' is used for output.
+
+void assign_section_ids(issue & is, section_registry const & sections);
+  // Set 'is.sections' to the ids of the tags in 'is.tags'.
+  // Every tag must be known to 'sections', see 'add_unknown_sections'.
+
 
 inline int stoi(const std::string& s)
 {
@@ -24,36 +24,33 @@
 
 // standard headers
 #include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <charconv>
+#include <chrono>
 #include <fstream>
-#include <functional>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <optional>
+#include <ranges>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <filesystem>
 namespace fs = std::filesystem;
 
 // solution specific headers
+#include "html_utils.h"
+#include "issue_cache.h"
 #include "issues.h"
+#include "mapped_file.h"
 #include "metadata.h"
 
 
-auto read_file_into_string(fs::path const & filename) -> std::string {
-   // read a text file completely into memory, and return its contents as
-   // a 'string' for further manipulation.
-
-   std::ifstream infile{filename};
-   if (!infile.is_open()) {
-      throw std::runtime_error{"Unable to open file " + filename.string()};
-   }
-
-   std::istreambuf_iterator<char> first{infile}, last{};
-   return std::string {first, last};
-}
-
 // Issue-list specific functionality for the rest of this file
 // ===========================================================
 
@@ -65,21 +62,82 @@ auto is_issue_xml_file(fs::directory_entry const & e) {
    return false;
 }
 
-void filter_issues(fs::path const & issues_path, lwg::metadata & meta, std::function<bool(lwg::issue const &)> predicate) {
+// A range of values, either end of which may be open.
+template <typename T>
+struct range {
+   std::optional<T> first;
+   std::optional<T> last;
+
+   auto contains(T const & x) const -> bool { return (!first || *first <= x) && (!last || x <= *last); }
+};
+
+// Case-insensitive search for 'needle' in 'haystack'.
+auto contains(std::string_view haystack, std::string_view needle) -> bool {
+   auto const lower = [](unsigned char c) { return std::tolower(c); };
+   return !std::ranges::search(haystack, needle, {}, lower, lower).empty();
+}
+
+// What an issue must match to be listed. Every criterion that is given must match,
+// and a criterion that is not given matches every issue.
+struct query {
+   std::bitset<lwg::status_count>   statuses;         // any of these, or any status if none
+   std::optional<range<int>>        priority;         // 99 for issues that have not been prioritised
+   std::vector<std::string>         section_prefixes; // any tag starting with any of these, e.g. "container." or "fund.ts.v2::"
+   std::string                      submitter;        // part of the submitter's name, ignoring case
+   std::optional<range<lwg::chrono::year_month_day>> opened;
+   std::optional<range<lwg::chrono::year_month_day>> modified;
+   std::string                      title;            // part of the title without markup, ignoring case
+
+   auto empty() const -> bool {
+      return statuses.none() && !priority && section_prefixes.empty() && submitter.empty() && !opened && !modified && title.empty();
+   }
+
+   auto matches(lwg::issue const & iss, lwg::chrono::year_month_day mod_date) const -> bool {
+      // The cheapest tests come first. 'mod_date' is used instead of 'iss.mod_date'.
+      if (statuses.any() && !statuses.test(static_cast<std::size_t>(iss.stat))) return false;
+      if (priority && !priority->contains(iss.priority)) return false;
+      if (opened && !opened->contains(iss.date)) return false;
+      if (modified && !modified->contains(mod_date)) return false;
+      if (!section_prefixes.empty() && std::ranges::none_of(iss.tags, [this](lwg::section_tag const & tag) {
+            auto const name = as_string(tag);
+            return std::ranges::any_of(section_prefixes, [&name](std::string const & prefix) { return name.starts_with(prefix); });
+         })) return false;
+      if (!submitter.empty() && !contains(iss.submitter, submitter)) return false;
+      if (!title.empty() && !contains(lwg::strip_xml_elements(iss.title), title)) return false;
+      return true;
+   }
+};
+
+void filter_issues(fs::path const & issues_path, lwg::metadata & meta, lwg::issue_cache & cache, query const & q) {
    // Open the specified directory, 'issues_path', and iterate all the '.xml' files
    // it contains, parsing each such file as an LWG issue document. Collect
-   // the number of every issue that satisfies the 'predicate'.
+   // the number of every issue that matches the query 'q'.
+   // Files that are unchanged since they were stored in 'cache' are not parsed again,
+   // so a query usually only hashes each file and tests the cached fields.
 
   std::vector<int> nums;
+  std::vector<std::string> names;
   for (auto ent : fs::directory_iterator(issues_path)) {
      if (is_issue_xml_file(ent)) {
-         fs::path const issue_file = ent.path();
-        auto const iss = parse_issue_from_file(read_file_into_string(issue_file), issue_file.string(), meta);
-        if (predicate(iss)) {
-          nums.push_back(iss.num);
+        fs::path const issue_file = ent.path();
+        lwg::mapped_file const file{issue_file};
+        auto const key = lwg::issue_cache::key(file.view());
+        names.push_back(issue_file.filename().string());
+        lwg::issue const * iss = cache.find(names.back(), key);
+        std::optional<lwg::issue> parsed;
+        if (!iss) {
+          parsed = parse_issue_from_file(file.view(), issue_file.string(), meta);
+          cache.insert(names.back(), key, *parsed);
+          iss = &*parsed;
+        }
+        // The cached date of the last change is not meaningful, and is only looked up if it is needed.
+        auto const mod_date = parsed || !q.modified ? iss->mod_date : lwg::report_date_file_last_modified(issue_file, meta);
+        if (q.matches(*iss, mod_date)) {
+          nums.push_back(iss->num);
         }
      }
   }
+  cache.retain(names);
   // Write the sorted issue numbers to stdout.
   std::ranges::sort(nums);
   std::ranges::copy(nums, std::ostream_iterator<int>(std::cout, "\n"));
@@ -93,25 +151,192 @@ void check_is_directory(fs::path const & directory) {
    }
 }
 
+constexpr std::string_view usage = R"(Usage: list_issues [STATUS] [OPTION...]
+List the numbers of the issues in ./xml that match every option given.
+  STATUS                     the same as --status=STATUS
+  --status=STATUS[,STATUS]   any of these statuses, e.g. "New,Open"
+  --class=CLASS[,CLASS]      any status in these classes: active, defect, closed, votable,
+                             ready, tentative or unresolved
+  --priority=N or N-M        priority in this range, e.g. "0-2" or "3-", or "none" for
+                             issues that have not been prioritised, which no range includes
+  --section=PREFIX           any section tag starting with PREFIX, e.g. "container."
+  --submitter=TEXT           submitter's name contains TEXT, ignoring case
+  --opened=FROM..TO          opened in this range, e.g. "2023-01-01..", or on a single DATE
+  --modified=FROM..TO        last changed in this range, or on a single DATE
+  --title=TEXT               title contains TEXT, ignoring case
+Options and their values may also be separated by a space.
+)";
+
+auto split(std::string_view list, char sep) -> std::vector<std::string_view> {
+   std::vector<std::string_view> parts;
+   for (auto part : list | std::views::split(sep)) {
+      parts.emplace_back(part.begin(), part.end());
+   }
+   return parts;
+}
+
+auto parse_int(std::string_view s, std::string_view what) -> int {
+   int n = 0;
+   auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), n);
+   if (s.empty() || ec != std::errc{} || end != s.data() + s.size()) {
+      throw std::runtime_error{"invalid " + std::string(what) + " '" + std::string(s) + "'"};
+   }
+   return n;
+}
+
+auto parse_status_class(std::string_view name) -> std::bitset<lwg::status_count> {
+   using predicate = auto (*)(lwg::status) noexcept -> bool;
+   static constexpr std::pair<std::string_view, predicate> classes[] = {
+      {"active",     lwg::is_active},
+      {"defect",     lwg::is_defect},
+      {"closed",     lwg::is_closed},
+      {"votable",    lwg::is_votable},
+      {"ready",      lwg::is_ready},
+      {"tentative",  lwg::is_tentative},
+      {"unresolved", lwg::is_not_resolved},
+   };
+   auto c = std::ranges::find(classes, name, &std::pair<std::string_view, predicate>::first);
+   if (c == std::ranges::end(classes)) {
+      throw std::runtime_error{"unknown status class '" + std::string(name) + "'"};
+   }
+   std::bitset<lwg::status_count> statuses;
+   for (std::size_t i = 0; i != lwg::status_count; ++i) {
+      statuses[i] = c->second(static_cast<lwg::status>(i));
+   }
+   return statuses;
+}
+
+auto parse_priority(std::string_view value) -> range<int> {
+   if (value == "none") {
+      return {99, 99};
+   }
+   auto const dash = value.find('-');
+   if (dash == value.npos) {
+      int p = parse_int(value, "priority");
+      return {p, p};
+   }
+   // A range never includes the issues that have not been prioritised, even "3-", only "none" does.
+   range<int> r{.last = 98};
+   if (dash != 0) r.first = parse_int(value.substr(0, dash), "priority");
+   if (dash + 1 != value.size()) r.last = std::min(parse_int(value.substr(dash + 1), "priority"), 98);
+   return r;
+}
+
+auto parse_iso_date(std::string_view value) -> lwg::chrono::year_month_day {
+   // YYYY-MM-DD
+   auto const parts = split(value, '-');
+   if (parts.size() == 3) {
+      lwg::chrono::year_month_day date{lwg::chrono::year{parse_int(parts[0], "date")},
+                                       lwg::chrono::month(parse_int(parts[1], "date")),
+                                       lwg::chrono::day(parse_int(parts[2], "date"))};
+      if (date.ok()) {
+         return date;
+      }
+   }
+   throw std::runtime_error{"invalid date '" + std::string(value) + "', expected YYYY-MM-DD"};
+}
+
+auto parse_date_range(std::string_view value) -> range<lwg::chrono::year_month_day> {
+   auto const dots = value.find("..");
+   if (dots == value.npos) {
+      auto date = parse_iso_date(value);
+      return {date, date};
+   }
+   range<lwg::chrono::year_month_day> r;
+   if (dots != 0) r.first = parse_iso_date(value.substr(0, dots));
+   if (dots + 2 != value.size()) r.last = parse_iso_date(value.substr(dots + 2));
+   return r;
+}
+
+auto parse_query(int argc, char const* argv[]) -> query {
+   query q;
+   for (int i = 1; i < argc; ++i) {
+      std::string_view const arg = argv[i];
+      std::string_view value;
+
+      // Match "--name VALUE" or "--name=VALUE"
+      auto option = [&](std::string_view name) {
+         if (arg == name) {
+            if (++i == argc) {
+               throw std::runtime_error{std::string(name) + " requires an argument"};
+            }
+            value = argv[i];
+            return true;
+         }
+         if (arg.starts_with(name) && arg.substr(name.size()).starts_with('=')) {
+            value = arg.substr(name.size() + 1);
+            return true;
+         }
+         return false;
+      };
+
+      if (option("--status")) {
+         for (auto stat : split(value, ',')) {
+            q.statuses.set(static_cast<std::size_t>(lwg::parse_status(stat)));
+         }
+      }
+      else if (option("--class")) {
+         for (auto name : split(value, ',')) {
+            q.statuses |= parse_status_class(name);
+         }
+      }
+      else if (option("--priority")) {
+         q.priority = parse_priority(value);
+      }
+      else if (option("--section")) {
+         // Accept the tag as it appears in the lists, e.g. "[container.requirements]"
+         if (value.starts_with('[')) value.remove_prefix(1);
+         if (value.ends_with(']')) value.remove_suffix(1);
+         q.section_prefixes.emplace_back(value);
+      }
+      else if (option("--submitter")) {
+         q.submitter = value;
+      }
+      else if (option("--opened")) {
+         q.opened = parse_date_range(value);
+      }
+      else if (option("--modified")) {
+         q.modified = parse_date_range(value);
+      }
+      else if (option("--title")) {
+         q.title = value;
+      }
+      else if (arg.starts_with("--")) {
+         throw std::runtime_error{"unknown option '" + std::string(arg) + "'"};
+      }
+      else {
+         q.statuses.set(static_cast<std::size_t>(lwg::parse_status(arg)));
+      }
+   }
+   return q;
+}
+
 int main(int argc, char const* argv[]) {
    try {
-      if (argc != 2) {
-         std::cerr << "Must specify exactly one status\n";
+      auto const q = parse_query(argc, argv);
+      if (q.empty()) {
+         std::cerr << usage;
          return 2;
       }
-      std::string const status{argv[1]};
-  
+
       fs::path path = fs::current_path();
 
       check_is_directory(path);
 
       auto metadata = lwg::metadata::read_from_path(path, /*verbose=*/ false);
 
-      filter_issues(path / "xml/", metadata, [status](lwg::issue const & iss) { return status == iss.stat; });
+      // Share the cache of parsed issues written by bin/lists.
+      auto const cache_file = path / ".lwg-cache" / "issues";
+      auto cache = lwg::issue_cache::load(cache_file);
+
+      filter_issues(path / "xml/", metadata, cache, q);
+
+      if (cache.changed()) {
+         cache.save(cache_file);
+      }
    }
    catch(std::exception const & ex) {
       std::cout << ex.what() << std::endl;
       return -1;
    }
 }
-
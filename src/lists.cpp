@@ -26,13 +26,17 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <charconv>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <regex>
 #include <set>
 #include <sstream>
@@ -46,26 +50,23 @@
 namespace fs = std::filesystem;
 
 // solution specific headers
+#include "directory_watcher.h"
 #include "html_utils.h"
+#include "http_server.h"
+#include "issue_cache.h"
+#include "issue_profile.h"
 #include "issues.h"
 #include "mailing_info.h"
+#include "mapped_file.h"
+#include "memory_profile.h"
+#include "page_manifest.h"
+#include "parallel.h"
 #include "report_generator.h"
 #include "sections.h"
+#include "timings.h"
+#include "trace.h"
 
 
-auto read_file_into_string(fs::path const & filename) -> std::string {
-   // read a text file completely into memory, and return its contents as
-   // a 'string' for further manipulation.
-
-   std::ifstream infile{filename};
-   if (!infile.is_open()) {
-      throw std::runtime_error{"Unable to open file " + filename.string()};
-   }
-
-   std::istreambuf_iterator<char> first{infile}, last{};
-   return std::string {first, last};
-}
-
 // Issue-list specific functionality for the rest of this file
 // ===========================================================
 
@@ -77,24 +78,73 @@ auto is_issue_xml_file(fs::directory_entry const & e) {
    return false;
 }
 
-auto read_issues(fs::path const & issues_path, lwg::metadata & meta) -> std::vector<lwg::issue> {
+auto read_issues(fs::path const & issues_path, lwg::metadata & meta, unsigned jobs, lwg::issue_cache & cache, lwg::issue_profile * profile = nullptr) -> std::vector<lwg::issue> {
    // Open the specified directory, 'issues_path', and iterate all the '.xml' files
    // it contains, parsing each such file as an LWG issue document.  Return the set
-   // of issues as a vector.
+   // of issues as a vector, in directory iteration order.
+   //
+   // The files are parsed concurrently using up to 'jobs' threads, each writing to
+   // its own element of the result.  Any sections that are unknown to 'meta.section_db'
+   // are added afterwards, in the same order as a sequential read would add them.
+   //
+   // Files whose contents are unchanged since they were stored in 'cache' are not
+   // parsed again.  On return 'cache' holds exactly the issues that were read.
+   //
+   // If 'profile' is not null, the time taken to parse each file is added to it.
 
-   std::vector<lwg::issue> issues{};
+   std::vector<fs::path> issue_files;
    for (auto ent : fs::directory_iterator(issues_path)) {
       if (is_issue_xml_file(ent)) {
-         fs::path const issue_file = ent.path();
-         issues.emplace_back(parse_issue_from_file(read_file_into_string(issue_file), issue_file.string(), meta));
+         issue_files.push_back(ent.path());
+      }
+   }
+
+   std::vector<lwg::issue> issues(issue_files.size());
+   std::vector<lwg::issue_cache::key_type> keys(issue_files.size());
+   std::vector<char> parsed(issue_files.size());
+   lwg::parallel_for(issue_files.size(), jobs, [&](std::size_t i) {
+      auto const filename = issue_files[i].string();
+      try {
+         lwg::mapped_file const file{issue_files[i]};
+         keys[i] = lwg::issue_cache::key(file.view());
+         if (auto is = cache.find(issue_files[i].filename().string(), keys[i])) {
+            issues[i] = *is;
+            issues[i].mod_date = lwg::report_date_file_last_modified(issue_files[i], meta);
+         }
+         else {
+            lwg::trace_span span{"parse", issue_files[i]};
+            auto const start = profile ? lwg::thread_cpu_time() : std::chrono::nanoseconds{};
+            issues[i] = parse_issue_from_file(file.view(), filename, meta);
+            parsed[i] = true;
+            if (profile) {
+               profile->add_parse(issues[i].num, lwg::thread_cpu_time() - start, file.view().size());
+            }
+         }
+      }
+      catch (lwg::bad_issue_file const &) {
+         throw;
+      }
+      catch (std::exception const & ex) {
+         // Errors such as a bad issue number do not mention the file, so add it.
+         throw lwg::bad_issue_file{filename, ex.what()};
       }
+   });
+
+   std::vector<std::string> names;
+   for (std::size_t i = 0; i != issues.size(); ++i) {
+      names.push_back(issue_files[i].filename().string());
+      if (parsed[i]) {
+         cache.insert(names.back(), keys[i], issues[i]);
+      }
+      lwg::add_unknown_sections(issues[i], meta.section_db);
    }
+   cache.retain(names);
 
    return issues;
 }
 
 
-auto read_issues_from_toc(std::string const & s) -> std::vector<std::tuple<int, std::string>> {
+auto read_issues_from_toc(std::string_view s) -> std::vector<std::tuple<int, std::string>> {
    // parse all issues from the specified stream, 'is'.
    // Throws 'runtime_error' if *any* parse step fails
    //
@@ -121,7 +171,7 @@ auto read_issues_from_toc(std::string const & s) -> std::vector<std::tuple<int,
       if (j == std::string::npos) {
          throw std::runtime_error{"unable to parse issue "+desc+": can't find beginning bracket"};
       }
-      return s.substr(j+1, i-j-1);
+      return std::string{s.substr(j+1, i-j-1)};
    };
 
    // Read all issues in table
@@ -232,10 +282,10 @@ std::string paper_title_attr(std::string paper_number, lwg::metadata& meta) {
 
 void format_issue_as_html(lwg::issue & is,
                           std::span<lwg::issue> issues,
-                          lwg::metadata & meta) {
+                          lwg::metadata & meta,
+                          lwg::section_registry const & sections) {
 
-   auto& section_db = meta.section_db;
-   std::vector<std::string> tag_stack; // stack of open XML tags as we parse
+   std::vector<std::string_view> tag_stack; // stack of open XML tags as we parse
 
    // Used by fix_tags to report errors.
    auto fail = [&is] (std::string_view reason, const Context& ctx) {
@@ -260,21 +310,6 @@ void format_issue_as_html(lwg::issue & is,
       throw std::runtime_error{err.str()};
    };
 
-   // Return the content of a quoted attribute, e.g. ref="[stable.name]"
-   auto get_attribute_value = [&fail](std::string_view attr, std::string_view elem, std::string_view data, const Context& ctx) {
-      if (auto o = lwg::get_attribute_of(attr, elem, data))
-         return *o;
-      fail(std::format("No {} attribute in <{}>", attr, elem), ctx);
-
-      // Can't put [[noreturn]] on a lambda until C++23,
-      // so we get warnings about a missing return here.
-#if __cpp_lib_unreachable
-      std::unreachable();
-#else
-      return std::string_view{};
-#endif
-   };
-
    // Check whether the character following a '<' is well-formed.
    // It has to be an opening or closing tag like <foo> or </foo>
    // or the start of a comment like <!--.
@@ -298,9 +333,8 @@ void format_issue_as_html(lwg::issue & is,
    //   !--             comments are simply erased
    //
    // In addition, as duplicate issues are discovered, the duplicates are marked up
-   // in the supplied range [first_issue,last_issue).  Similarly, if an unexpected
-   // (unknown) section is discovered, it will be inserted into the supplied
-   // section index, 'section_db'.
+   // in the supplied range [first_issue,last_issue).  A reference to an unknown
+   // section is shown without a section number.
    //
    // The behavior is undefined unless the issues in the supplied span are sorted by issue-number.
    //
@@ -309,44 +343,70 @@ void format_issue_as_html(lwg::issue & is,
 
    auto fix_tags = [&](std::string &s) {
 
-      // Loop over the input looking for '< characters.
-      // Cannot rewrite as range-based for-loop as the string 's' is modified within the loop.
-      for (auto i = s.find('<'); i < s.size(); i = s.find('<', i+1)) {
-         Context context{s, i};
+      // Build the result in a new string, in a single pass over 's'.
+      std::string out;
+      out.reserve(s.size() + s.size() / 4);
+
+      // Errors are reported in the context of the partly rewritten text,
+      // i.e. the output so far followed by the rest of the input.
+      std::string context_text;
+      auto context = [&](std::size_t i) {
+         context_text = out;
+         context_text += std::string_view(s).substr(i);
+         return Context{context_text, out.size()};
+      };
+
+      // Return the content of a quoted attribute of the tag 'element' at s[i], e.g. ref="[stable.name]"
+      auto get_attribute_value = [&](std::string_view attr, std::string_view elem, std::string_view element, std::size_t i) {
+         if (auto o = lwg::get_attribute_of(attr, elem, element))
+            return *o;
+         fail(std::format("No {} attribute in <{}>", attr, elem), context(i));
+
+         // Can't put [[noreturn]] on a lambda until C++23,
+         // so we get warnings about a missing return here.
+#if __cpp_lib_unreachable
+         std::unreachable();
+#else
+         return std::string_view{};
+#endif
+      };
 
-         if (!start_element_or_comment(s[i+1])) {
-            fail("Unescaped '<'", context);
+      std::size_t done = 0; // s[0, done) has been processed
+      for (auto i = s.find('<'); i < s.size(); i = s.find('<', done)) {
+         out.append(s, done, i - done);
+
+         if (!start_element_or_comment(i+1 < s.size() ? s[i+1] : '\0')) {
+            fail("Unescaped '<'", context(i));
          }
 
          auto j = s.find('>', i);
          if (j == std::string::npos) {
-            fail("Missing '>'", context);
+            fail("Missing '>'", context(i));
          }
+         done = j + 1;
 
-         std::string tag;
-         {
-            std::istringstream iword{s.substr(i+1, j-i-1)};
-            iword >> tag;
-         }
+         // The tag is the first word after the '<'.
+         std::string_view element(s.data() + i, j - i + 1);
+         std::string_view tag = element.substr(1, element.size() - 2);
+         tag = tag.substr(0, tag.find_first_of(" \t\n\v\f\r"));
 
          if (tag.empty()) {
-            fail("Unexpected <>", context);
+            fail("Unexpected <>", context(i));
          }
 
          if (tag[0] == '/') { // closing tag
-             tag.erase(tag.begin());
+             tag.remove_prefix(1);
 
              if (tag_stack.empty()  or  tag != tag_stack.back()) {
-                fail_mismatched_tag(tag, context);
+                fail_mismatched_tag(tag, context(i));
              }
 
              tag_stack.pop_back();
              if (auto r = substitutions.find(tag); r != substitutions.end()) {
-                 s.replace(i, j-i + 1, r->second.second);
-                 i += r->second.second.size() - 1;
+                 out += r->second.second;
              }
              else {
-                 i = j;
+                 out += element;
              }
 
              continue;
@@ -354,24 +414,21 @@ void format_issue_as_html(lwg::issue & is,
 
          if (s[j-1] == '/') { // self-closing tag: sref, iref, paper
 
-            std::string_view attrs(s);
-            attrs.remove_prefix(i);
-
             // format section references
             if (tag == "sref") {
                lwg::section_tag tag;
                tag.prefix = is.doc_prefix;
-               auto section_name = get_attribute_value("ref", "sref", attrs, context);
+               auto section_name = get_attribute_value("ref", "sref", element, i);
                tag.name = section_name.substr(1, section_name.size() - 2);
 
                // heuristic: if the name is not found using the doc_prefix, try
                // using no prefix (i.e. the C++ standard itself)
-               if (!tag.prefix.empty() && section_db.find(tag) == section_db.end())
+               if (!tag.prefix.empty() && !sections.find(tag))
                {
                  //std::cout << "issue:" << is.num << " tag" << tag << '\n';
                  lwg::section_tag fallback_tag;
                  fallback_tag.name = tag.name;
-                 if (section_db.find(fallback_tag) != section_db.end())
+                 if (sections.find(fallback_tag))
                  {
                    //std::cout << "bingo\n";
                    tag = fallback_tag;
@@ -379,50 +436,45 @@ void format_issue_as_html(lwg::issue & is,
                  }
                }
 
-               j -= i - 1;
-               std::string r = lwg::format_section_tag_as_link(section_db, tag);
-               s.replace(i, j, r);
-               i += r.size() - 1;
+               sections.append_link(out, tag);
                continue;
             }
 
             // format issue references
             else if (tag == "iref") {
-               std::string r{get_attribute_value("ref", "iref", attrs, context)};
+               std::string_view r = get_attribute_value("ref", "iref", element, i);
                int num;
                {
-                  std::istringstream temp{r};
-                  temp >> num;
-                  if (temp.fail()) {
-                     fail("Bad number in <iref>", context);
+                  auto digits = r.substr(std::min(r.find_first_not_of(" \t\n\v\f\r"), r.size()));
+                  if (digits.starts_with('+')) {
+                     digits.remove_prefix(1);
+                  }
+                  auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), num);
+                  if (ec != std::errc{}) {
+                     fail("Bad number in <iref>", context(i));
                   }
                }
 
                auto n = std::ranges::lower_bound(issues, num, {}, &lwg::issue::num);
                if (n == issues.end()  or  n->num != num) {
-                  fail("Could not find issue " + r + " for <iref>", context);
+                  fail("Could not find issue " + std::string(r) + " for <iref>", context(i));
                }
 
                if (!tag_stack.empty()  and  tag_stack.back() == "duplicate") {
                   n->duplicates.insert(make_html_anchor(is));
                   is.duplicates.insert(make_html_anchor(*n));
-                  r.clear();
                }
                else {
-                  r = make_html_anchor(*n);
+                  out += make_html_anchor(*n);
                }
-
-               j -= i - 1;
-               s.replace(i, j, r);
-               i += r.size() - 1;
                continue;
             }
             else if (tag == "paper") {
-               std::string paper_number{get_attribute_value("num", "paper", attrs, context)};
+               std::string paper_number{get_attribute_value("num", "paper", element, i)};
                static const std::regex acceptable_numbers(R"(N\d+|[DP]\d+R\d+|[DP]\d+)", std::regex::icase);
 
                if (!std::regex_match(paper_number, acceptable_numbers)) {
-                  fail("Invalid paper number '" + paper_number + "'", context);
+                  fail("Invalid paper number '" + paper_number + "'", context(i));
                }
 
                // normalize paper numbers to use uppercase
@@ -431,41 +483,40 @@ void format_issue_as_html(lwg::issue & is,
 
                auto title = paper_title_attr(paper_number, meta);
 
-               j -= i - 1;
-               std::string r = "<a href=\"https://wg21.link/" + paper_number + "\"" + title + ">" + paper_number + "</a>";
-               s.replace(i, j, r);
-               i += r.size() - 1;
+               out += "<a href=\"https://wg21.link/";
+               out += paper_number;
+               out += '"';
+               out += title;
+               out += '>';
+               out += paper_number;
+               out += "</a>";
                continue;
             }
-            i = j;
+            out += element;
             continue;  // don't worry about this <tag/>
          }
 
          tag_stack.push_back(tag);
          if (tag == "resolution") {
-             std::ostringstream os;
-             os << "<p id=\"res-" << is.num << "\"><b>Proposed resolution:</b></p>";
-             auto r = os.str();
-             s.replace(i, j-i + 1, r);
-             i += r.length() - 1;
+             out += std::format("<p id=\"res-{}\"><b>Proposed resolution:</b></p>", is.num);
          }
          else if (auto r = substitutions.find(tag); r != substitutions.end()) {
-             s.replace(i, j-i + 1, r->second.first);
-             i += r->second.first.size() - 1;
+             out += r->second.first;
          }
          else if (tag == "!--") {
+             // Comments are erased, and an unterminated comment erases everything after it.
              tag_stack.pop_back();
-             j = s.find("-->", i);
-             j += 3;
-             s.erase(i, j-i);
-             --i;
+             auto end = s.find("-->", i);
+             done = end == s.npos ? s.size() : end + 3;
          }
          else {
-             i = j;
+             out += element;
          }
       }
+      out.append(s, std::min(done, s.size()));
       if (!tag_stack.empty())
-         throw std::runtime_error("Unclosed tag <" + tag_stack.back() + "> in issue " + std::to_string(is.num));
+         throw std::runtime_error("Unclosed tag <" + std::string(tag_stack.back()) + "> in issue " + std::to_string(is.num));
+      s = std::move(out);
    };
 
    fix_tags(is.text);
@@ -473,7 +524,7 @@ void format_issue_as_html(lwg::issue & is,
 }
 
 
-void prepare_issues(std::span<lwg::issue> issues, lwg::metadata & meta) {
+void prepare_issues(std::span<lwg::issue> issues, lwg::metadata & meta, lwg::section_registry const & sections, lwg::issue_profile * profile = nullptr) {
    // Initially sort the issues by issue number, so each issue can be correctly 'format'ted
   std::ranges::sort(issues, {}, &lwg::issue::num);
 
@@ -483,18 +534,25 @@ void prepare_issues(std::span<lwg::issue> issues, lwg::metadata & meta) {
    // Currently, the 'format' function takes a span of non-const-issues purely to
    // mark up information related to duplicates, so processing duplicates in a separate pass may
    // clarify the code.
-   for (auto & i : issues) { format_issue_as_html(i, issues, meta); }
+   for (auto & i : issues) { assign_section_ids(i, sections); }
+   for (auto & i : issues) {
+      lwg::trace_span span{"format", "format_issue_as_html", i.num};
+      auto const start = profile ? lwg::thread_cpu_time() : std::chrono::nanoseconds{};
+      format_issue_as_html(i, issues, meta, sections);
+      if (profile) {
+         profile->add_format(i.num, lwg::thread_cpu_time() - start);
+      }
+   }
 
-   // Issues will be routinely re-sorted in later code, but contents should be fixed after formatting.
-   // This suggests we may want to be storing some kind of issue handle in the functions that keep
-   // re-sorting issues, and so minimize the churn on the larger objects.
+   // Contents should be fixed after formatting. Later code filters and re-sorts lwg::issue_ref
+   // handles to the issues, rather than the larger objects themselves.
 }
 
 
 // ============================================================================================================
 
 auto prepare_issues_for_diff_report(std::vector<lwg::issue> const & issues) -> std::vector<std::tuple<int, std::string>> {
-   auto make_tuple = [](lwg::issue const & iss) { return std::make_tuple(iss.num, iss.stat); };
+   auto make_tuple = [](lwg::issue const & iss) { return std::make_tuple(iss.num, std::string(as_string(iss.stat))); };
 #ifdef __cpp_lib_ranges_to_container
    return std::ranges::to<std::vector>(issues | std::views::transform(make_tuple));
 #else
@@ -703,140 +761,606 @@ void check_is_directory(fs::path const & directory) {
    }
 }
 
-int main(int argc, char* argv[]) {
-   try {
-      fs::path path;
-      bool revhist = false;
-      std::cout << "Preparing new LWG issues lists..." << std::endl;
-      if (argc == 2) {
-         path = argv[1];
-      }
-      else {
-         path = fs::current_path();
+auto parse_jobs(std::string const & arg) -> unsigned {
+   int n = lwg::stoi(arg);
+   if (n < 1) {
+      throw std::runtime_error{"--jobs must be at least 1"};
+   }
+   return n;
+}
 
-         if (argc == 3 && std::string(argv[1]) == "revision" && std::string(argv[2]) == "history")
-            revhist = true;
-      }
+auto parse_count(std::string const & arg, std::string const & option) -> std::size_t {
+   int n = lwg::stoi(arg);
+   if (n < 1) {
+      throw std::runtime_error{option + " must be at least 1"};
+   }
+   return n;
+}
 
-      check_is_directory(path);
+auto parse_port(std::string const & arg) -> std::uint16_t {
+   int n = lwg::stoi(arg);
+   if (n < 1 || n > 65535) {
+      throw std::runtime_error{"--serve requires a port from 1 to 65535"};
+   }
+   return static_cast<std::uint16_t>(n);
+}
+
+// The options given on the command line.
+struct options {
+   bool revhist = false;
+   unsigned jobs = lwg::default_jobs();
+   bool rebuild_cache = false;
+   // With --cache-dir DIR, parsed issues are cached in DIR instead of in .lwg-cache in the issues directory.
+   fs::path cache_dir;
+   bool incremental = false;
+   bool write_if_changed = false;
+   bool watch = false;
+   // With --serve PORT, the documents are served on localhost instead of being written.
+   std::uint16_t serve_port = 0;
+   // With --timings, or LWG_TIMINGS=1, each step reports how long it took. LWG_TIMINGS=0 turns this off.
+   // With --timings=FILE, or LWG_TIMINGS=FILE, the report is also written to FILE as JSON.
+   bool timings = false;
+   fs::path timings_file;
+   // With --memory-profile, each step reports how much memory it allocated.
+   bool memory_profile = false;
+   // With --profile-issues[=N], the N issues that took longest are reported, with a histogram of
+   // the CPU time taken by each issue.
+   std::size_t profile_issues = 0;
+   // With --trace FILE, what each thread does is written to FILE as a trace for chrome://tracing or Perfetto.
+   fs::path trace_file;
+};
+
+// The inputs that --watch keeps in memory from one run to the next, so that only
+// the files that changed are read again.
+struct resident_inputs {
+   lwg::issue_cache             cache;                 // every issue parsed so far
+   bool                         cache_loaded = false;  // the cache file has been read
+   std::optional<lwg::metadata> metadata;              // as read from meta-data/, before any issues were read
+};
 
-      const fs::path target_path{path / "mailing"};
-      check_is_directory(target_path);
+// Everything the documents are made from.
+struct lists_inputs {
+   lwg::metadata                              metadata;
+   std::vector<std::tuple<int, std::string>>  old_issues;      // as listed in the last published lists
+   std::optional<lwg::mailing_info>           lwg_issues_xml;
+   std::vector<lwg::issue>                    issues;          // sorted by number
+   std::optional<lwg::section_registry const> sections;
+};
 
-      auto metadata = lwg::metadata::read_from_path(path);
+void read_inputs(fs::path const & path, options const & opt, lists_inputs & in, lwg::stage_timer & timer,
+                 lwg::issue_profile * profile, resident_inputs * resident) {
+   // Read everything in 'path' that the documents are made from, and prepare the issues.
+   // If 'resident' is not null, inputs it already holds are used instead of being read again,
+   // and what is read is added to it.
+
+   // The steps that read the inputs and make the documents form a graph of tasks, run by up to
+   // 'jobs' threads, which also run the loops over the issues within a step. (The issue pages
+   // are written by one more thread, which mostly waits for the disk.) Each task only depends
+   // on the tasks that produce what it uses, so that independent steps overlap. Each document
+   // is written by a single task, so the output is the same however many threads are used,
+   // and '--jobs 1' runs the steps in this order.
+   lwg::task_graph loading;
+
+   auto const read_metadata = loading.add(timer.timed("read metadata", [&] {
+      if (resident && resident->metadata) {
+         in.metadata = *resident->metadata;
+         return;
+      }
+      in.metadata = lwg::metadata::read_from_path(path);
+      if (resident) {
+         resident->metadata = in.metadata;
+      }
 #if defined (DEBUG_LOGGING)
       // dump the contents of the section index
-      for (auto const & elem : metadata.section_db) {
+      for (auto const & elem : in.metadata.section_db) {
          std::string temp = elem.first;
          temp.erase(temp.end()-1);
          temp.erase(temp.begin());
          std::cout << temp << ' ' << elem.second << '\n';
       }
 #endif
+   }));
+
+   loading.add(timer.timed("read old issues list", [&] {
+      in.old_issues = read_issues_from_toc(lwg::mapped_file{path / "meta-data" / "lwg-toc.old.html"}.view());
+   }));
+
+   auto const issues_path = path / "xml";
+
+   loading.add(timer.timed("read lwg-issues.xml", [&] {
+      in.lwg_issues_xml.emplace(lwg::mapped_file{issues_path / "lwg-issues.xml"});
+   }));
+
+   // Parsed issues are cached outside the output directory, so that the cache is kept when the
+   // output is made from scratch. A full rebuild ignores any existing cache.
+   // A resident cache is only loaded the first time.
+   auto const cache_file = (opt.cache_dir.empty() ? path / ".lwg-cache" : opt.cache_dir) / "issues";
+   lwg::issue_cache local_cache;
+   lwg::issue_cache & cache = resident ? resident->cache : local_cache;
+   auto const load_cache = loading.add(timer.timed("load issue cache", [&] {
+      if (opt.rebuild_cache) {
+         cache = {};
+      }
+      else if (!resident || !resident->cache_loaded) {
+         cache = lwg::issue_cache::load(cache_file);
+      }
+      if (resident) {
+         resident->cache_loaded = true;
+      }
+   }));
 
-      auto const old_issues = read_issues_from_toc(read_file_into_string(path / "meta-data" / "lwg-toc.old.html"));
+   auto const read_all_issues = loading.add(timer.timed("read issues", [&] {
+      std::cout << "Reading issues from: " << issues_path << std::endl;
+      in.issues = read_issues(issues_path, in.metadata, opt.jobs, cache, profile);
+      if (opt.rebuild_cache || cache.changed()) {
+         cache.save(cache_file);
+      }
+   }, [&] { return lwg::stage_size{in.issues.size()}; }), {read_metadata, load_cache});
 
-      auto const issues_path = path / "xml";
+   // Now that every section is known, give each one an id.
+   loading.add(timer.timed("prepare issues", [&] {
+      in.sections.emplace(in.metadata.section_db);
+      prepare_issues(in.issues, in.metadata, *in.sections, profile);
+   }, [&] { return lwg::stage_size{in.issues.size()}; }), {read_all_issues});
 
-      lwg::mailing_info lwg_issues_xml = [&issues_path](){
-         fs::path filename{issues_path / "lwg-issues.xml"};
-         std::ifstream infile{filename};
-         if (!infile.is_open()) {
-            throw std::runtime_error{"Unable to open " + filename.string()};
-         }
+   loading.run(opt.jobs);
+}
 
-         return lwg::mailing_info{infile};
-      }();
+// The issues listed by each set of index documents.
+// These are handles to the issues, so that each index can filter and re-sort them without copying issues.
+struct index_sets {
+   std::vector<lwg::issue_ref> all;
+   std::vector<lwg::issue_ref> unresolved;
+   std::vector<lwg::issue_ref> votable;
+};
 
-      //lwg::mailing_info lwg_issues_xml{issues_path};
+auto make_index_sets(std::vector<lwg::issue> const & issues) -> index_sets {
+   index_sets sets;
+   sets.all.assign(issues.begin(), issues.end());
 
+   std::copy_if(issues.begin(), issues.end(), std::back_inserter(sets.unresolved), [](lwg::issue const & iss){ return lwg::is_not_resolved(iss.stat); } );
+   std::copy_if(issues.begin(), issues.end(), std::back_inserter(sets.votable),    [](lwg::issue const & iss){ return lwg::is_votable(iss.stat); } );
 
-      std::cout << "Reading issues from: " << issues_path << std::endl;
-      auto issues = read_issues(issues_path, metadata);
-      prepare_issues(issues, metadata);
+   // If votable list is empty, we are between meetings and should list Ready issues instead
+   // Otherwise, issues moved to Ready during a meeting will remain 'unresolved' by that meeting
+   auto ready_inserter = sets.votable.empty()
+                       ? std::back_inserter(sets.votable)
+                       : std::back_inserter(sets.unresolved);
+   std::copy_if(issues.begin(), issues.end(), ready_inserter, [](lwg::issue const & iss){ return lwg::is_ready(iss.stat); } );
+   return sets;
+}
 
+// A document made from the issues, other than the individual issue pages.
+struct document {
+   std::string                               stage;     // for the timings
+   std::string                               filename;
+   std::size_t                               count;     // the number of issues it is made from
+   std::function<void(fs::path const & dir)> make;      // write the document in 'dir'
+};
 
-      lwg::report_generator generator{lwg_issues_xml, metadata.section_db};
-      generator.set_timestamp_from_issues(issues);
+auto documents(lwg::report_generator & generator, std::vector<lwg::issue> const & issues, index_sets const & sets,
+               std::string const & diff_report) -> std::vector<document> {
+   // Every document in the mailing. Each one can be made more than once, and independently of the others.
+   std::vector<document> docs;
+
+   // First the primary 3 standard issues lists
+   docs.push_back({"make_active", "lwg-active.html", issues.size(), [&](fs::path const & dir) { generator.make_active(issues, dir, diff_report); }});
+   docs.push_back({"make_defect", "lwg-defects.html", issues.size(), [&](fs::path const & dir) { generator.make_defect(issues, dir, diff_report); }});
+   docs.push_back({"make_closed", "lwg-closed.html", issues.size(), [&](fs::path const & dir) { generator.make_closed(issues, dir, diff_report); }});
+
+   // unofficial documents
+   docs.push_back({"make_tentative",  "lwg-tentative.html",  issues.size(), [&](fs::path const & dir) { generator.make_tentative (issues, dir); }});
+   docs.push_back({"make_unresolved", "lwg-unresolved.html", issues.size(), [&](fs::path const & dir) { generator.make_unresolved(issues, dir); }});
+   docs.push_back({"make_immediate",  "lwg-immediate.html",  issues.size(), [&](fs::path const & dir) { generator.make_immediate (issues, dir); }});
+   docs.push_back({"make_ready",      "lwg-ready.html",      issues.size(), [&](fs::path const & dir) { generator.make_ready     (issues, dir); }});
+   // docs.push_back({"make_editors_issues", "lwg-issues.html", issues.size(), [&](fs::path const & dir) { generator.make_editors_issues(issues, dir); }});
+
+   // Then the index documents.
+   // Note that each of these functions is going to re-sort the handles it is given for its own purposes,
+   // so each one sorts its own copy of the handles.
+   auto index = [&](auto make, std::vector<lwg::issue_ref> const & handles, std::string filename, auto... args) {
+      docs.push_back({"make " + filename, filename, handles.size(), [&generator, make, handles, filename, args...](fs::path const & dir) {
+         auto copy = handles;
+         (generator.*make)(copy, dir / filename, args...);
+      }});
+   };
+   using lwg::report_generator;
+   index(&report_generator::make_sort_by_num,             sets.all, "lwg-toc.html");
+   index(&report_generator::make_sort_by_status,          sets.all, "lwg-status.html");
+   index(&report_generator::make_sort_by_status_mod_date, sets.all, "lwg-status-date.html");
+   index(&report_generator::make_sort_by_section,         sets.all, "lwg-index.html", false);
+
+   // Note that this additional document is very similar to unresolved-index.html below
+   index(&report_generator::make_sort_by_section,         sets.all, "lwg-index-open.html", true);
+
+   // Make a similar set of index documents for the issues that are 'live' during a meeting
+   // Note that these documents want to reference each other, rather than lwg- equivalents,
+   // although it may not be worth attempting fix-ups as the per-issue level
+   // During meetings, it would be good to list newly-Ready issues here
+   index(&report_generator::make_sort_by_num,             sets.unresolved, "unresolved-toc.html");
+   index(&report_generator::make_sort_by_status,          sets.unresolved, "unresolved-status.html");
+   index(&report_generator::make_sort_by_status_mod_date, sets.unresolved, "unresolved-status-date.html");
+   index(&report_generator::make_sort_by_section,         sets.unresolved, "unresolved-index.html", false);
+   index(&report_generator::make_sort_by_priority,        sets.unresolved, "unresolved-prioritized.html");
+
+   // Make another set of index documents for the issues that are up for a vote during a meeting
+   // Note that these documents want to reference each other, rather than lwg- equivalents,
+   // although it may not be worth attempting fix-ups as the per-issue level
+   // Between meetings, it would be good to list Ready issues here
+   index(&report_generator::make_sort_by_num,             sets.votable, "votable-toc.html");
+   index(&report_generator::make_sort_by_status,          sets.votable, "votable-status.html");
+   index(&report_generator::make_sort_by_status_mod_date, sets.votable, "votable-status-date.html");
+   index(&report_generator::make_sort_by_section,         sets.votable, "votable-index.html", false);
+
+   return docs;
+}
 
+auto remove_stale_pages(fs::path const & dir, std::set<std::string> const & pages) -> std::size_t {
+   // Remove every page in 'dir' that is not one of 'pages', e.g. the page of an issue that has been
+   // renumbered, which is otherwise left behind when existing pages are kept.
+   // Return the number of pages removed.
+   std::vector<fs::path> stale;
+   for (auto const & ent : fs::directory_iterator(dir)) {
+      auto const name = ent.path().filename().string();
+      if (ent.is_regular_file() && name.ends_with(".html") && !pages.contains(name)) {
+         stale.push_back(ent.path());
+      }
+   }
+   for (auto const & file : stale) {
+      fs::remove(file);
+   }
+   return stale.size();
+}
 
-      // issues must be sorted by number before making the mailing list documents
-      // std::ranges::sort(issues, {}, &lwg::issue::num);
+void make_lists(fs::path const & path, options const & opt, resident_inputs * resident = nullptr) {
+   // Make the documents in 'path'/mailing from the issues in 'path'/xml.
+   // If 'resident' is not null, inputs it already holds are used instead of being read again,
+   // and what is read is added to it.
 
-      // Collect a report on all issues that have changed status
-      // This will be added to the revision history of the 3 standard documents
-      auto const new_issues = prepare_issues_for_diff_report(issues);
+   const fs::path target_path{path / "mailing"};
+   check_is_directory(target_path);
 
-      if (revhist) {
-         std::cout << "\n<revision tag=\"" << lwg_issues_xml.get_revision() << "\">\n"
-            << lwg_issues_xml.get_date()  << ' ' << lwg_issues_xml.get_title() << '\n';
-         print_current_revisions(std::cout, old_issues, new_issues);
-         std::cout << "</revision>\n";
-         return 0;
-      }
+   // With --watch, each run writes a trace of that run only.
+   if (!opt.trace_file.empty()) {
+      lwg::trace::start();
+   }
+
+   lwg::issue_profile issue_costs;
+   lwg::stage_timer timer{opt.timings || opt.memory_profile};
+
+   lists_inputs in;
+   read_inputs(path, opt, in, timer, opt.profile_issues ? &issue_costs : nullptr, resident);
+   auto const & issues = in.issues;
+
+   lwg::report_generator generator{*in.lwg_issues_xml, *in.sections, opt.jobs};
+   generator.set_timestamp_from_issues(issues);
+   generator.write_only_changed_pages(opt.write_if_changed);
+   if (opt.profile_issues) {
+      generator.profile_issues(issue_costs);
+   }
+
+
+   // issues must be sorted by number before making the mailing list documents
+   // std::ranges::sort(issues, {}, &lwg::issue::num);
+
+   // Collect a report on all issues that have changed status
+   // This will be added to the revision history of the 3 standard documents
+   auto const new_issues = prepare_issues_for_diff_report(issues);
+
+   if (opt.revhist) {
+      std::cout << "\n<revision tag=\"" << in.lwg_issues_xml->get_revision() << "\">\n"
+         << in.lwg_issues_xml->get_date()  << ' ' << in.lwg_issues_xml->get_title() << '\n';
+      print_current_revisions(std::cout, in.old_issues, new_issues);
+      std::cout << "</revision>\n";
+      return;
+   }
 
+   std::string diff_report;
+   timer.timed("revision history", [&] {
       std::ostringstream os_diff_report;
-      print_current_revisions(os_diff_report, old_issues, new_issues );
-      auto const diff_report = os_diff_report.str();
-
-      std::vector<lwg::issue> unresolved_issues;
-      std::vector<lwg::issue> votable_issues;
-
-      std::copy_if(issues.begin(), issues.end(), std::back_inserter(unresolved_issues), [](lwg::issue const & iss){ return lwg::is_not_resolved(iss.stat); } );
-      std::copy_if(issues.begin(), issues.end(), std::back_inserter(votable_issues),    [](lwg::issue const & iss){ return lwg::is_votable(iss.stat); } );
-
-      // If votable list is empty, we are between meetings and should list Ready issues instead
-      // Otherwise, issues moved to Ready during a meeting will remain 'unresolved' by that meeting
-      auto ready_inserter = votable_issues.empty()
-                          ? std::back_inserter(votable_issues)
-                          : std::back_inserter(unresolved_issues);
-      std::copy_if(issues.begin(), issues.end(), ready_inserter, [](lwg::issue const & iss){ return lwg::is_ready(iss.stat); } );
-
-      // First generate the primary 3 standard issues lists
-      generator.make_active(issues, target_path, diff_report);
-      generator.make_defect(issues, target_path, diff_report);
-      generator.make_closed(issues, target_path, diff_report);
-
-      // unofficial documents
-      generator.make_tentative (issues, target_path);
-      generator.make_unresolved(issues, target_path);
-      generator.make_immediate (issues, target_path);
-      generator.make_ready     (issues, target_path);
-      // generator.make_editors_issues(issues, target_path);
-      generator.make_individual_issues(issues, target_path);
-
-
-
-      // Now we have a parsed and formatted set of issues, we can write the standard set of HTML documents
-      // Note that each of these functions is going to re-sort the 'issues' vector for its own purposes
-      generator.make_sort_by_num            (issues, {target_path / "lwg-toc.html"});
-      generator.make_sort_by_status         (issues, {target_path / "lwg-status.html"});
-      generator.make_sort_by_status_mod_date(issues, {target_path / "lwg-status-date.html"});
-      generator.make_sort_by_section        (issues, {target_path / "lwg-index.html"});
-
-      // Note that this additional document is very similar to unresolved-index.html below
-      generator.make_sort_by_section        (issues, {target_path / "lwg-index-open.html"}, true);
-
-      // Make a similar set of index documents for the issues that are 'live' during a meeting
-      // Note that these documents want to reference each other, rather than lwg- equivalents,
-      // although it may not be worth attempting fix-ups as the per-issue level
-      // During meetings, it would be good to list newly-Ready issues here
-      generator.make_sort_by_num            (unresolved_issues, {target_path / "unresolved-toc.html"});
-      generator.make_sort_by_status         (unresolved_issues, {target_path / "unresolved-status.html"});
-      generator.make_sort_by_status_mod_date(unresolved_issues, {target_path / "unresolved-status-date.html"});
-      generator.make_sort_by_section        (unresolved_issues, {target_path / "unresolved-index.html"});
-      generator.make_sort_by_priority       (unresolved_issues, {target_path / "unresolved-prioritized.html"});
-
-      // Make another set of index documents for the issues that are up for a vote during a meeting
-      // Note that these documents want to reference each other, rather than lwg- equivalents,
-      // although it may not be worth attempting fix-ups as the per-issue level
-      // Between meetings, it would be good to list Ready issues here
-      generator.make_sort_by_num            (votable_issues, {target_path / "votable-toc.html"});
-      generator.make_sort_by_status         (votable_issues, {target_path / "votable-status.html"});
-      generator.make_sort_by_status_mod_date(votable_issues, {target_path / "votable-status-date.html"});
-      generator.make_sort_by_section        (votable_issues, {target_path / "votable-index.html"});
-
-      std::cout << "Made all documents\n";
+      print_current_revisions(os_diff_report, in.old_issues, new_issues );
+      diff_report = os_diff_report.str();
+   }, [&] { return lwg::stage_size{issues.size(), diff_report.size()}; })();
+
+   // Record what each page is made from, so that the next run with --incremental
+   // only writes the pages that would change. The manifest is removed until all
+   // pages have been written, so that a failed run cannot leave it out of date.
+   auto const manifest_file = target_path / ".page-manifest";
+   auto manifest = lwg::page_manifest::load(manifest_file);
+   fs::remove(manifest_file);
+   generator.track_pages(issues, manifest, opt.incremental);
+
+   // Most documents show the same HTML for each issue, render it once for all of them.
+   timer.timed("render issues", [&] { generator.render_issues(issues); },
+               [&] { return lwg::stage_size{issues.size()}; })();
+
+   // All documents only read the issues, so they can be made concurrently.
+   lwg::task_graph writing;
+
+   // The size of what a document task made, for the timings.
+   auto made = [&](std::size_t count, fs::path filename) {
+      return [&generator, count, filename = target_path / filename] { return lwg::stage_size{count, generator.bytes_written(filename)}; };
+   };
+   auto const docs = documents(generator, issues, make_index_sets(issues), diff_report);
+   for (auto const & doc : docs) {
+      writing.add(timer.timed(doc.stage, [&doc, &target_path] { doc.make(target_path); }, made(doc.count, doc.filename)));
+   }
+   writing.add(timer.timed("make_individual_issues", [&] { generator.make_individual_issues(issues, target_path); },
+                           [&] { return lwg::stage_size{issues.size(), generator.issue_bytes_written()}; }));
+
+   writing.run(opt.jobs);
+
+   manifest.save(manifest_file);
+   if (opt.incremental) {
+      std::cout << "Skipped " << generator.pages_skipped() << " unchanged pages\n";
+   }
+   if (opt.write_if_changed) {
+      std::cout << "Kept " << generator.pages_unchanged() << " unchanged pages\n";
+   }
+   if (opt.incremental || opt.write_if_changed) {
+      std::set<std::string> pages;
+      for (auto const & doc : docs) {
+         pages.insert(doc.filename);
+      }
+      for (auto const & iss : issues) {
+         pages.insert(std::to_string(iss.num) + ".html");
+      }
+      std::cout << "Removed " << remove_stale_pages(target_path, pages) << " pages that are no longer made\n";
+   }
+   std::cout << "Wrote " << generator.issue_pages_written() << " issue pages ("
+             << generator.issue_bytes_written() << " bytes)\n";
+
+   std::cout << "Made all documents\n";
+   if (opt.timings) {
+      timer.print(std::cout);
+   }
+   if (opt.memory_profile) {
+      timer.print_memory(std::cout);
+   }
+   if (opt.profile_issues) {
+      issue_costs.print(std::cout, opt.profile_issues);
+   }
+   if (!opt.timings_file.empty()) {
+      std::ofstream out{opt.timings_file};
+      timer.print_json(out);
+      if (!out)
+         throw std::runtime_error{"Failed to write " + opt.timings_file.string()};
+   }
+   if (!opt.trace_file.empty()) {
+      std::ofstream out{opt.trace_file};
+      lwg::trace::write(out);
+      if (!out)
+         throw std::runtime_error{"Failed to write " + opt.trace_file.string()};
+   }
+}
+
+[[noreturn]] void serve(fs::path const & path, options const & opt) {
+   // Serve the documents for the issues in 'path'/xml on localhost, until interrupted.
+   // Nothing is written to 'path'/mailing, only the issue cache is updated. Each document, and each
+   // issue's own page, is only made when it is first asked for, then kept in memory, so that
+   // looking at one issue does not make the pages for all the others.
+   lwg::stage_timer timer{false};
+   lists_inputs in;
+   read_inputs(path, opt, in, timer, nullptr, nullptr);
+   auto const & issues = in.issues;
+
+   lwg::report_generator generator{*in.lwg_issues_xml, *in.sections, opt.jobs};
+   generator.set_timestamp_from_issues(issues);
+
+   std::ostringstream diff_report;
+   print_current_revisions(diff_report, in.old_issues, prepare_issues_for_diff_report(issues));
+
+   // Every page made so far, by file name.
+   std::map<std::string, std::string> pages;
+   generator.send_pages_to([&pages](fs::path const & filename, std::string contents) {
+      pages[filename.filename().string()] = std::move(contents);
+   });
+   auto const diff = diff_report.str();
+   auto const docs = documents(generator, issues, make_index_sets(issues), diff);
+
+   auto page_for = [&](std::string const & name) -> std::string const * {
+      if (auto page = pages.find(name); page != pages.end()) {
+         return &page->second;
+      }
+      if (auto doc = std::ranges::find(docs, name, &document::filename); doc != docs.end()) {
+         doc->make({});
+         return &pages.at(name);
+      }
+      // An issue's own page, e.g. 1234.html
+      auto const stem = std::string_view(name).substr(0, name.size() - 5);
+      int num = 0;
+      auto const [end, ec] = std::from_chars(stem.data(), stem.data() + stem.size(), num);
+      if (stem.empty() || ec != std::errc{} || end != stem.data() + stem.size()) {
+         return nullptr;
+      }
+      auto iss = std::ranges::lower_bound(issues, num, {}, &lwg::issue::num);
+      if (iss == issues.end() || iss->num != num) {
+         return nullptr;
+      }
+      return &(pages[name] = generator.issue_page(issues, *iss));
+   };
+
+   std::cout << "Serving " << issues.size() << " issues on http://localhost:" << opt.serve_port << "/" << std::endl;
+   lwg::serve_http(opt.serve_port, [&](std::string_view target) -> lwg::http_response {
+      // The lists link to each issue's page without the .html extension, as on the published site.
+      std::string name{target.substr(1)};
+      if (name.empty()) {
+         name = "lwg-toc.html";
+      }
+      else if (!name.ends_with(".html")) {
+         name += ".html";
+      }
+      auto const page = page_for(name);
+      std::cout << target << (page ? "" : " not found") << std::endl;
+      if (!page) {
+         return {404, "text/plain; charset=utf-8", "No such page: " + std::string(target) + '\n'};
+      }
+      return {200, "text/html; charset=utf-8", *page};
+   });
+}
+
+auto is_input_file(fs::path const & file) -> bool {
+   // Editors' swap files, backups and other temporary files are not inputs.
+   auto const name = file.filename().string();
+   return !name.empty() && !name.starts_with('.') && !name.ends_with('~') && !name.ends_with(".swp")
+      && (file.parent_path().filename() != "xml" || name.ends_with(".xml"));
+}
+
+[[noreturn]] void watch(fs::path const & path, options opt) {
+   // Make the documents, then make them again each time an input changes, until interrupted.
+   // The parsed issues and the metadata stay in memory, so only the files that changed are
+   // parsed again, and only the pages that depend on what changed are written again.
+   // A run that fails, e.g. because an issue being edited is not valid yet, is reported and
+   // the next change is waited for.
+   using namespace std::chrono_literals;
+
+   lwg::directory_watcher watcher{{path / "xml", path / "meta-data"}};
+   resident_inputs resident;
+   for (;;) {
+      try {
+         make_lists(path, opt, &resident);
+      }
+      catch (std::exception const & ex) {
+         std::cout << ex.what() << std::endl;
+      }
+
+      opt.incremental = true;
+      if (!opt.profile_issues) {
+         opt.rebuild_cache = false;
+      }
+
+      std::cout << "Watching " << path / "xml" << " and " << path / "meta-data" << " for changes..." << std::endl;
+      std::vector<fs::path> changed;
+      while (changed.empty()) {
+         changed = watcher.wait(100ms);
+         std::erase_if(changed, [](fs::path const & file) { return !is_input_file(file); });
+      }
+      for (auto const & file : changed) {
+         std::cout << "Changed: " << file << '\n';
+         if (file.parent_path() == path / "meta-data") {
+            resident.metadata.reset();
+         }
+      }
+   }
+}
+
+int main(int argc, char* argv[]) {
+   try {
+      fs::path path;
+      options opt;
+      if (char const * env = std::getenv("LWG_TIMINGS"); env && *env) {
+         // Anything other than a boolean is the name of the JSON file.
+         std::string_view const value = env;
+         bool const off = value == "0" || value == "false" || value == "no" || value == "off";
+         bool const on  = value == "1" || value == "true" || value == "yes" || value == "on";
+         opt.timings = !off;
+         if (!off && !on) {
+            opt.timings_file = env;
+         }
+      }
+
+      // Options may appear anywhere, everything else is a positional argument.
+      std::vector<std::string> args;
+      for (int i = 1; i < argc; ++i) {
+         std::string arg = argv[i];
+         if (arg == "--jobs" || arg == "-j") {
+            if (++i == argc) {
+               throw std::runtime_error{arg + " requires an argument"};
+            }
+            opt.jobs = parse_jobs(argv[i]);
+         }
+         else if (arg.starts_with("--jobs=")) {
+            opt.jobs = parse_jobs(arg.substr(7));
+         }
+         else if (arg == "--cache-dir") {
+            if (++i == argc) {
+               throw std::runtime_error{arg + " requires an argument"};
+            }
+            opt.cache_dir = argv[i];
+         }
+         else if (arg.starts_with("--cache-dir=")) {
+            opt.cache_dir = arg.substr(12);
+         }
+         else if (arg == "--rebuild-cache") {
+            opt.rebuild_cache = true;
+         }
+         else if (arg == "--incremental") {
+            opt.incremental = true;
+         }
+         else if (arg == "--write-if-changed") {
+            opt.write_if_changed = true;
+         }
+         else if (arg == "--watch") {
+            opt.watch = true;
+         }
+         else if (arg == "--serve") {
+            if (++i == argc) {
+               throw std::runtime_error{arg + " requires an argument"};
+            }
+            opt.serve_port = parse_port(argv[i]);
+         }
+         else if (arg.starts_with("--serve=")) {
+            opt.serve_port = parse_port(arg.substr(8));
+         }
+         else if (arg == "--timings") {
+            opt.timings = true;
+         }
+         else if (arg.starts_with("--timings=")) {
+            opt.timings = true;
+            opt.timings_file = arg.substr(10);
+         }
+         else if (arg == "--memory-profile") {
+            opt.memory_profile = true;
+         }
+         else if (arg == "--profile-issues") {
+            opt.profile_issues = 20;
+         }
+         else if (arg.starts_with("--profile-issues=")) {
+            opt.profile_issues = parse_count(arg.substr(17), "--profile-issues");
+         }
+         else if (arg == "--trace") {
+            if (++i == argc) {
+               throw std::runtime_error{arg + " requires an argument"};
+            }
+            opt.trace_file = argv[i];
+         }
+         else if (arg.starts_with("--trace=")) {
+            opt.trace_file = arg.substr(8);
+         }
+         else {
+            args.push_back(std::move(arg));
+         }
+      }
+
+      if (opt.memory_profile) {
+         lwg::memory::start_counting();
+      }
+      // Issues read from the cache are not parsed, so a profile reads every issue again.
+      if (opt.profile_issues) {
+         opt.rebuild_cache = true;
+      }
+
+      std::cout << "Preparing new LWG issues lists..." << std::endl;
+      if (args.size() == 1) {
+         path = args[0];
+      }
+      else {
+         path = fs::current_path();
+
+         if (args.size() == 2 && args[0] == "revision" && args[1] == "history")
+            opt.revhist = true;
+      }
+
+      check_is_directory(path);
+
+      if (opt.serve_port) {
+         serve(path, opt);
+      }
+      if (!opt.watch) {
+         make_lists(path, opt);
+         return 0;
+      }
+      watch(path, opt);
    }
    catch(std::exception const & ex) {
       std::cout << ex.what() << std::endl;
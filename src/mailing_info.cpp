@@ -1,13 +1,14 @@
 #include "mailing_info.h"
 
+#include "fingerprint.h"
 #include "issues.h"
 
 #include "html_utils.h"
 
 #include <algorithm>
 #include <format>
-#include <istream>
 #include <iterator>
+#include <utility>
 #include <cstring>
 
 namespace {
@@ -65,16 +66,46 @@ auto lwg::make_html_anchor(lwg::issue const & iss) -> std::string {
    title = lwg::replace_reserved_char(std::move(title), '"', "&quot;");
 
    return std::format("<a href=\"{1}\" title=\"{2} (Status: {3})\">{1}</a>",
-       filename_for_status(iss.stat), num, title, iss.stat);
+       filename_for_status(iss.stat), num, title, as_string(iss.stat));
 }
 
 namespace lwg
 {
 
-mailing_info::mailing_info(std::istream & stream)
-   : m_data{std::istreambuf_iterator<char>{stream},
-            std::istreambuf_iterator<char>{}}
-   {
+mailing_info::mailing_info(mapped_file file)
+   : m_file{std::move(file)}
+{
+   xml_pull_parser parser{data()};
+   for (auto tok = parser.next(); tok.kind != xml_token::end_of_input; tok = parser.next()) {
+      if (tok.is_start()) {
+         m_root = tok;
+         break;
+      }
+   }
+   if (m_root.kind != xml_token::start_tag) {
+      return;
+   }
+
+   for (auto tok = parser.next(); tok.kind != xml_token::end_of_input and !tok.is_end(m_root.name); tok = parser.next()) {
+      if (!tok.is_start()) {
+         continue;
+      }
+      auto elem = parser.read_element(tok);
+      if (!elem) {
+         break;
+      }
+      if (tok.name == "intro") {
+         if (auto list = tok.attribute("list")) {
+            m_intros.emplace_back(*list, elem->inner);
+         }
+      }
+      else if (tok.name == "statuses" and !m_statuses) {
+         m_statuses = elem->inner;
+      }
+      else if (tok.name == "revision_history" and !m_revision_history) {
+         m_revision_history = elem->inner;
+      }
+   }
 }
 
 auto mailing_info::get_doc_number(std::string doc) const -> std::string_view {
@@ -96,28 +127,24 @@ auto mailing_info::get_doc_number(std::string doc) const -> std::string_view {
 
 auto mailing_info::get_intro(std::string_view doc) const -> std::string_view {
     if (doc == "active") {
-        doc = "<intro list=\"Active\">";
+        doc = "Active";
     }
     else if (doc == "defect") {
-        doc = "<intro list=\"Defects\">";
+        doc = "Defects";
     }
     else if (doc == "closed") {
-        doc = "<intro list=\"Closed\">";
+        doc = "Closed";
     }
     else {
         throw std::runtime_error{"unknown argument to intro: " + std::string{doc}};
     }
 
-    auto i = m_data.find(doc);
-    if (i == std::string::npos) {
-        throw std::runtime_error{"Unable to find intro in lwg-issues.xml"};
-    }
-    i += doc.size();
-    auto j = m_data.find("</intro>", i);
-    if (j == std::string::npos) {
-        throw std::runtime_error{"Unable to parse intro in lwg-issues.xml"};
+    for (auto const & [list, intro] : m_intros) {
+        if (list == doc) {
+            return intro;
+        }
     }
-    return std::string_view{m_data}.substr(i, j-i);
+    throw std::runtime_error{"Unable to find intro in lwg-issues.xml"};
 }
 
 
@@ -125,7 +152,7 @@ auto mailing_info::get_intro(std::string_view doc) const -> std::string_view {
 // turned into an HTML <a href="mailto:..."> link.
 auto mailing_info::get_maintainer() const -> std::string {
    std::string_view r;
-   if (auto o = lwg::get_attribute("maintainer", m_data))
+   if (auto o = m_root.attribute("maintainer"))
       r = *o;
    else
       throw std::runtime_error{"Unable to find <maintainer> in lwg-issues.xml"};
@@ -155,8 +182,8 @@ auto mailing_info::get_revision() const -> std::string_view {
 auto mailing_info::get_revisions(std::span<const issue> issues, std::string const & diff_report) const -> std::string {
 
    std::string_view revs;
-   if (auto o = lwg::get_element_content("revision_history", m_data))
-      revs = *o;
+   if (m_revision_history)
+      revs = *m_revision_history;
    else
       throw std::runtime_error{"Unable to find <revision_history> in lwg-issues.xml"};
 
@@ -164,15 +191,17 @@ auto mailing_info::get_revisions(std::span<const issue> issues, std::string cons
    std::string r = std::format("<ul>\n<li>{}: {} {}{}</li>\n",
        get_revision(), get_date(), get_title(), diff_report);
 
-   while (revs.find("<revision tag=") != revs.npos) {
-      if (auto rev = lwg::get_element("revision", revs)) {
-         auto rv = *lwg::get_attribute_of("tag", "revision", rev->outer);
-         r += std::format("<li>{}: {}</li>\n", rv, rev->inner);
-         revs.remove_prefix(rev->outer.data() - revs.data()); // remove ws
-         revs.remove_prefix(rev->outer.size());
+   xml_pull_parser parser{revs};
+   for (auto tok = parser.next(); tok.kind != xml_token::end_of_input; tok = parser.next()) {
+      if (!tok.is_start("revision")) {
+         continue;
       }
-      else
+      auto rv = tok.attribute("tag");
+      auto rev = parser.read_element(tok);
+      if (!rv or !rev) {
          throw std::runtime_error{"Invalid <revision> element in <revisions>"};
+      }
+      r += std::format("<li>{}: {}</li>\n", *rv, rev->inner);
    }
    r += "</ul>\n";
 
@@ -183,8 +212,8 @@ auto mailing_info::get_revisions(std::span<const issue> issues, std::string cons
 
 
 auto mailing_info::get_statuses() const -> std::string_view {
-   if (auto o = lwg::get_element_content("statuses", m_data))
-      return *o;
+   if (m_statuses)
+      return *m_statuses;
    throw std::runtime_error{"Unable to find statuses in lwg-issues.xml"};
 }
 
@@ -196,8 +225,12 @@ auto mailing_info::get_title() const -> std::string_view {
    return get_attribute("title");
 }
 
+auto mailing_info::content_hash() const noexcept -> std::uint64_t {
+   return fingerprint{}.add_bytes(data()).value();
+}
+
 auto mailing_info::get_attribute(std::string_view attribute_name) const -> std::string_view {
-   if (auto o = lwg::get_attribute(attribute_name, m_data))
+   if (auto o = m_root.attribute(attribute_name))
       return *o;
    throw std::runtime_error{std::format("Unable to find {} in lwg-issues.xml", attribute_name)};
 }
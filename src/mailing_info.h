@@ -1,10 +1,16 @@
 #ifndef INCLUDE_LWG_MAILING_INFO_H
 #define INCLUDE_LWG_MAILING_INFO_H
 
-#include <iosfwd>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <span>
+#include <utility>
+#include <vector>
+
+#include "html_utils.h"
+#include "mapped_file.h"
 
 namespace lwg
 {
@@ -12,7 +18,7 @@ namespace lwg
 struct issue;
 
 struct mailing_info {
-   explicit mailing_info(std::istream & stream);
+   explicit mailing_info(mapped_file file);
 
    auto get_doc_number(std::string doc) const -> std::string_view;
    auto get_intro(std::string_view doc) const -> std::string_view;
@@ -23,18 +29,29 @@ struct mailing_info {
    auto get_date() const -> std::string_view;
    auto get_title() const -> std::string_view;
 
+   auto content_hash() const noexcept -> std::uint64_t;
+      // A fingerprint of the whole of lwg-issues.xml, to detect changes since an earlier run.
+
 private:
    auto get_attribute(std::string_view attribute_name) const -> std::string_view;
-      // Return the value of the first xml attibute having the specified 'attribute_name'
-      // in the stored XML string, 'm_data', without regard to which element holds that
-      // attribute.
-
-   std::string m_data;
-      // 'm_data' is reparsed too many times in practice, and memory use is not a major concern.
-      // Should cache each of the reproducible calls in additional member strings, either at
-      // construction, or lazily on each function eval, checking if the cached string is 'empty'.
-      // Note that 'm_data' is immutable, we can use string_view with confidence.
+      // Return the value of the attribute having the specified 'attribute_name'
+      // on the root element of lwg-issues.xml.
+
+   auto data() const noexcept -> std::string_view { return m_file.view(); }
+      // The contents of lwg-issues.xml
+
+   mapped_file m_file;
+      // Note that 'm_file' is immutable, and views of it remain valid when it is moved,
+      // so we can use string_view with confidence.
       // However, we do not mark it as 'const', as it would kill the implicit move constructor.
+
+   // The parts of 'm_file' that are used, found by a single pass over it at construction.
+   xml_token m_root;
+      // The start tag of the root element, which has the attributes describing the whole list.
+   std::vector<std::pair<std::string_view, std::string_view>> m_intros;
+      // The 'list' attribute and content of each <intro> element.
+   std::optional<std::string_view> m_statuses;
+   std::optional<std::string_view> m_revision_history;
 };
 
 }
@@ -0,0 +1,272 @@
+// This program writes a synthetic LWG issues directory, for benchmarking the other programs.
+//
+// Usage: make_corpus <directory> <number of issues> <section.data>...
+//
+// The issues refer to sections of the given section.data files, to each other and to papers,
+// and contain code blocks, notes, proposed resolutions and duplicates, like the real issues.
+// The same arguments always produce exactly the same files.
+
+// standard headers
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// solution specific headers
+#include "mapped_file.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// A small deterministic generator, so that the corpus does not depend on the standard library
+// implementation of the <random> distributions.
+struct rng {
+   std::uint64_t state;
+
+   auto next() -> std::uint64_t {
+      // splitmix64
+      std::uint64_t z = (state += 0x9e3779b97f4a7c15);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      return z ^ (z >> 31);
+   }
+
+   auto below(std::size_t n) -> std::size_t { return next() % n; }
+   auto between(int lo, int hi) -> int { return lo + static_cast<int>(below(hi - lo + 1)); }
+   auto percent(int p) -> bool { return below(100) < static_cast<std::size_t>(p); }
+
+   template<typename T>
+   auto pick(std::vector<T> const & v) -> T const & { return v[below(v.size())]; }
+};
+
+std::vector<std::string> const statuses {
+   "Voting", "Tentatively Voting", "Immediate", "Ready", "Tentatively Ready", "Tentatively NAD",
+   "Review", "New", "New", "New", "Open", "Open", "LEWG", "EWG", "Core", "SG1", "SG16", "Deferred",
+   "Pending WP", "Pending NAD", "NAD Future", "DR", "WP", "C++23", "C++20", "C++20", "C++17",
+   "C++14", "C++11", "CD1", "TC1", "Resolved", "Resolved", "TS", "NAD Editorial", "NAD", "NAD",
+   "Dup", "NAD Concepts",
+};
+
+std::vector<std::string> const submitters {
+   "Alisdair Meredith", "Howard Hinnant", "Jonathan Wakely", "Tim Song", "Casey Carter",
+   "Jiang An", "Hewill Kang", "Daniel Kr&uuml;gler",
+};
+
+std::vector<std::string> const titles {
+   "<tt>basic_string</tt> should be `constexpr`",
+   "Missing \"noexcept\" on swap",
+   "`ranges::to` &amp; friends",
+   "Wording for <code>views::zip</code>",
+   "Underspecified precondition for <tt>vector::insert</tt>",
+};
+
+std::vector<std::string> const papers { "N4861", "P0896R4", "P1206R7", "P2300R10", "N4950" };
+
+constexpr std::string_view months[] { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+struct section_list {
+   std::string              prefix;  // e.g. "networking.ts", empty for the IS
+   std::vector<std::string> tags;    // e.g. "vector.modifiers"
+};
+
+// Read the stable names from a section.data file, grouped by document.
+void read_sections(std::string_view data, std::vector<section_list> & docs) {
+   while (!data.empty()) {
+      auto eol = data.find('\n');
+      auto line = data.substr(0, eol);
+      data.remove_prefix(eol == data.npos ? data.size() : eol + 1);
+
+      auto open = line.rfind('[');
+      auto close = line.rfind(']');
+      if (open == line.npos || close == line.npos || close < open) {
+         continue;
+      }
+      std::string prefix;
+      auto first = line.find_first_not_of(" \t");
+      if (first != line.npos && !std::isdigit(static_cast<unsigned char>(line[first])) && line[first] != '[') {
+         auto end = line.find(' ', first);
+         prefix = std::string(line.substr(first, end - first));
+         if (prefix.size() == 1 && std::isupper(static_cast<unsigned char>(prefix[0]))) {
+            prefix.clear();  // an annex letter
+         }
+      }
+      auto tag = std::string(line.substr(open + 1, close - open - 1));
+      if (docs.empty() || docs.back().prefix != prefix) {
+         docs.push_back({prefix, {}});
+      }
+      docs.back().tags.push_back(std::move(tag));
+   }
+}
+
+// The document of a section reference is given by the "[prefix]" in the issue title,
+// so the reference itself is only the stable name.
+auto sref(std::string const & tag) -> std::string {
+   return std::format("<sref ref=\"[{}]\"/>", tag);
+}
+
+auto paragraph(rng & r, section_list const & doc, std::vector<int> const & nums) -> std::string {
+   std::string p = "<p>";
+   for (int n = r.between(1, 6); n != 0; --n) {
+      auto k = r.below(20);
+      if (k < 4)       p += "see " + sref(r.pick(doc.tags)) + ' ';
+      else if (k < 7)  p += std::format("related to <iref ref=\"{}\"/> ", r.pick(nums));
+      else if (k < 9)  p += std::format("per <paper num=\"{}\"/> ", r.pick(papers));
+      else if (k < 12) p += "the expression `x < y && (a > b)` is ill-formed ";
+      else if (k < 13) p += "a ``quoted'' phrase ";
+      else if (k < 14) p += "<tt>std::vector&lt;T&gt;</tt> and <tt>allocator_traits</tt> ";
+      else for (int i = r.between(1, 8); i != 0; --i) p += "lorem ipsum dolor sit amet ";
+   }
+   p += "</p>\n";
+   return p;
+}
+
+void write_file(fs::path const & filename, std::string const & contents) {
+   std::ofstream out{filename};
+   if (!out)
+      throw std::runtime_error{"Failed to open " + filename.string()};
+   out << contents;
+}
+
+void make_corpus(fs::path const & dir, int count, std::vector<section_list> const & docs) {
+   fs::create_directories(dir / "xml");
+   fs::create_directories(dir / "meta-data");
+   fs::create_directories(dir / "mailing");
+
+   rng r{42};
+
+   // Issue numbers have a few gaps, like the real list
+   std::vector<int> nums;
+   for (int num = 1; static_cast<int>(nums.size()) < count; ++num) {
+      if (!r.percent(4)) {
+         nums.push_back(num);
+      }
+   }
+
+   std::string dates;
+   std::string toc = "<table>\n<tr><th>Issue</th><th>Status</th></tr>\n";
+   for (int num : nums) {
+      // Most issues are against the IS, the first document
+      auto const & doc = r.percent(90) ? docs.front() : r.pick(docs);
+      auto const & stat = r.pick(statuses);
+
+      std::string title = r.pick(titles);
+      if (!doc.prefix.empty()) {
+         title = "[" + doc.prefix + "] " + title;
+      }
+
+      std::string sections;
+      for (int n = r.percent(85) ? 1 : r.between(2, 3); n != 0; --n) {
+         sections += sref(r.pick(doc.tags));
+      }
+
+      std::string discussion;
+      for (int n = r.between(1, 5); n != 0; --n) {
+         discussion += paragraph(r, doc, nums);
+      }
+      if (r.percent(30)) {
+         discussion += "\n```\ntemplate<class T> requires (sizeof(T) > 1 && true)\nvoid f(T&);\n```\n";
+      }
+      if (r.percent(30)) {
+         discussion += "<note>2020-01-01; Reflector poll</note>\n";
+      }
+      if (stat == "Dup") {
+         discussion += std::format("<duplicate><iref ref=\"{}\"/></duplicate>\n", r.pick(nums));
+      }
+
+      std::string resolution = "\n";
+      if (r.percent(80)) {
+         resolution = std::format(
+            "<p>This wording is relative to <paper num=\"N4950\"/>.</p>\n"
+            "<ol><li><p>Modify {} as indicated:</p>\n"
+            "<blockquote><pre>\n<ins>void f();</ins>\n<del>void g();</del>\n</pre></blockquote></li></ol>\n",
+            sref(r.pick(doc.tags)));
+      }
+
+      std::string priority;
+      if (r.percent(60)) {
+         priority = std::format("<priority>{}</priority>\n", r.between(0, 4));
+      }
+
+      write_file(dir / "xml" / std::format("issue{:0>4}.xml", num), std::format(
+         "<?xml version='1.0' encoding='utf-8' standalone='no'?>\n"
+         "<!DOCTYPE issue SYSTEM \"lwg-issue.dtd\">\n\n"
+         "<issue num=\"{}\" status=\"{}\">\n<title>{}</title>\n<section>{}</section>\n"
+         "<submitter>{}</submitter>\n<date>{} {} {}</date>\n{}\n"
+         "<discussion>\n{}</discussion>\n\n<resolution>\n{}</resolution>\n\n</issue>\n",
+         num, stat, title, sections, r.pick(submitters),
+         r.between(1, 28), months[r.below(12)], r.between(1998, 2025), priority,
+         discussion, resolution));
+
+      dates += std::format("{} {}\n", num, 900'000'000 + num * 86400LL + r.between(0, 100'000'000));
+      if (r.percent(90)) {
+         toc += std::format("<tr><td><a href=\"x\">{}</a></td><td><a href=\"y\">{}</a></td></tr>\n",
+                            num, r.percent(80) ? stat : r.pick(statuses));
+      }
+   }
+   toc += "</table>\n";
+
+   write_file(dir / "meta-data" / "dates", dates);
+   write_file(dir / "meta-data" / "lwg-toc.old.html", toc);
+   write_file(dir / "meta-data" / "paper_titles.txt",
+      "N4861 Working Draft, Standard for Programming Language C++\n"
+      "P0896R4 The One Ranges Proposal\n"
+      "P1206R7 Conversions from ranges to containers\n"
+      "P2300R10 std::execution\n");
+   write_file(dir / "xml" / "lwg-issues.xml", std::format(
+      "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+      "<issueslist revision=\"R123\" active_docno=\"N5001\" defect_docno=\"N5002\" closed_docno=\"N5003\""
+      " date=\"2025-10-01\" title=\"pre-Kona mailing\" maintainer=\"Jonathan Wakely &lt;lwgchair@gmail.com&gt;\">\n"
+      "<intro list=\"Active\"><p>Active intro.</p></intro>\n"
+      "<intro list=\"Defects\"><p>Defects intro.</p></intro>\n"
+      "<intro list=\"Closed\"><p>Closed intro.</p></intro>\n"
+      "<statuses><p>Status list.</p></statuses>\n"
+      "<revision_history>\n"
+      "<revision tag=\"R122\">2025-06-01 post-Sofia mailing. Fixed <iref ref=\"{}\"/>.</revision>\n"
+      "<revision tag=\"R121\">2025-03-01 pre-Sofia mailing.</revision>\n"
+      "</revision_history>\n"
+      "</issueslist>\n", nums.front()));
+}
+
+} // close unnamed namespace
+
+int main(int argc, char* argv[]) {
+   try {
+      if (argc < 4) {
+         std::cerr << "Usage: " << argv[0] << " <directory> <number of issues> <section.data>...\n";
+         return 2;
+      }
+      fs::path const dir = argv[1];
+      int const count = std::atoi(argv[2]);
+      if (count < 1) {
+         throw std::runtime_error{"The number of issues must be at least 1"};
+      }
+
+      std::vector<section_list> docs;
+      std::string section_data;
+      for (int i = 3; i < argc; ++i) {
+         auto data = lwg::read_file_into_string(argv[i]);
+         read_sections(data, docs);
+         section_data += data;
+      }
+      if (docs.empty()) {
+         throw std::runtime_error{"No sections found"};
+      }
+
+      fs::create_directories(dir / "meta-data");
+      write_file(dir / "meta-data" / "section.data", section_data);
+      make_corpus(dir, count, docs);
+      std::cout << "Made " << count << " issues in " << dir << '\n';
+   }
+   catch (std::exception const & ex) {
+      std::cout << ex.what() << std::endl;
+      return 1;
+   }
+}
@@ -0,0 +1,93 @@
+#include "mapped_file.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+# define LWG_HAVE_MMAP 1
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace lwg
+{
+
+mapped_file::mapped_file(std::filesystem::path const & filename) {
+#ifdef LWG_HAVE_MMAP
+   int fd = ::open(filename.c_str(), O_RDONLY);
+   if (fd < 0) {
+      throw std::runtime_error{"Unable to open file " + filename.string()};
+   }
+   struct ::stat st;
+   if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error{"Unable to read file " + filename.string()};
+   }
+   // An empty file cannot be mapped, but then there is nothing to view anyway.
+   if (st.st_size > 0) {
+      void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+         m_addr = addr;
+         m_size = st.st_size;
+      }
+   }
+   ::close(fd);
+   if (m_addr || st.st_size == 0) {
+      return;
+   }
+   // Fall back to reading the file, e.g. for files on filesystems that cannot be mapped.
+#endif
+
+   std::ifstream infile{filename, std::ios::binary};
+   if (!infile.is_open()) {
+      throw std::runtime_error{"Unable to open file " + filename.string()};
+   }
+   infile.seekg(0, std::ios::end);
+   auto const size = infile.tellg();
+   if (size < 0) {
+      throw std::runtime_error{"Unable to read file " + filename.string()};
+   }
+   m_buffer.resize(static_cast<std::size_t>(size));
+   infile.seekg(0);
+   if (!infile.read(m_buffer.data(), size)) {
+      throw std::runtime_error{"Unable to read file " + filename.string()};
+   }
+}
+
+mapped_file::mapped_file(mapped_file && other) noexcept
+   : m_addr{std::exchange(other.m_addr, nullptr)}
+   , m_size{std::exchange(other.m_size, 0)}
+   , m_buffer{std::move(other.m_buffer)}
+{
+}
+
+mapped_file & mapped_file::operator=(mapped_file && other) noexcept {
+   if (this != &other) {
+#ifdef LWG_HAVE_MMAP
+      if (m_addr) {
+         ::munmap(m_addr, m_size);
+      }
+#endif
+      m_addr = std::exchange(other.m_addr, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+      m_buffer = std::move(other.m_buffer);
+   }
+   return *this;
+}
+
+mapped_file::~mapped_file() {
+#ifdef LWG_HAVE_MMAP
+   if (m_addr) {
+      ::munmap(m_addr, m_size);
+   }
+#endif
+}
+
+auto read_file_into_string(std::filesystem::path const & filename) -> std::string {
+   return std::string{mapped_file{filename}.view()};
+}
+
+} // close namespace lwg
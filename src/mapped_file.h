@@ -0,0 +1,46 @@
+#ifndef INCLUDE_LWG_MAPPED_FILE_H
+#define INCLUDE_LWG_MAPPED_FILE_H
+
+// standard headers
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lwg
+{
+
+// The read-only contents of a whole file.
+// Where the platform supports it the file is memory-mapped, so that callers
+// can inspect it through a 'string_view' without copying it into a 'string'.
+// Otherwise the file is read into memory with a single bulk read.
+// The view remains valid if the 'mapped_file' is moved, but is invalidated
+// when it is destroyed or assigned to.
+struct mapped_file {
+   explicit mapped_file(std::filesystem::path const & filename);
+      // Throws 'runtime_error' if the file cannot be opened or read.
+
+   mapped_file(mapped_file && other) noexcept;
+   mapped_file & operator=(mapped_file && other) noexcept;
+   ~mapped_file();
+
+   auto view() const noexcept -> std::string_view {
+      return m_addr ? std::string_view{static_cast<char const *>(m_addr), m_size} : std::string_view{m_buffer.data(), m_buffer.size()};
+   }
+
+private:
+   void*       m_addr = nullptr;   // start of the mapping, or null if not mapped
+   std::size_t m_size = 0;         // length of the mapping
+   std::vector<char> m_buffer;     // contents of the file, if not mapped
+                                   // (not a string, whose small buffer would move)
+};
+
+auto read_file_into_string(std::filesystem::path const & filename) -> std::string;
+   // Read a text file completely into memory, and return its contents as
+   // a 'string' for further manipulation. Prefer 'mapped_file' if the
+   // contents do not need to be modified.
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_MAPPED_FILE_H
@@ -0,0 +1,68 @@
+#include "memory_profile.h"
+
+#include <cstdlib>
+#include <new>
+
+#if __has_include(<sys/resource.h>)
+# include <sys/resource.h>
+#endif
+
+namespace
+{
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::uint64_t> bytes{0};
+}
+
+void lwg::memory::start_counting() {
+   detail::counting = true;
+}
+
+auto lwg::memory::allocated() noexcept -> usage {
+   return { allocations.load(std::memory_order_relaxed), bytes.load(std::memory_order_relaxed) };
+}
+
+auto lwg::memory::peak_rss() noexcept -> std::uintmax_t {
+#if __has_include(<sys/resource.h>)
+   rusage r{};
+   if (getrusage(RUSAGE_SELF, &r) == 0) {
+# if defined(__APPLE__)
+      return static_cast<std::uintmax_t>(r.ru_maxrss);         // bytes
+# else
+      return static_cast<std::uintmax_t>(r.ru_maxrss) * 1024;  // kilobytes
+# endif
+   }
+#endif
+   return 0;
+}
+
+// The replacement allocation functions. The array and nothrow forms of 'operator new'
+// call this one by default, so they are counted too.
+void * operator new(std::size_t size) {
+   if (lwg::memory::counting()) {
+      allocations.fetch_add(1, std::memory_order_relaxed);
+      bytes.fetch_add(size, std::memory_order_relaxed);
+      ++lwg::memory::detail::thread_usage.allocations;
+      lwg::memory::detail::thread_usage.bytes += size;
+   }
+   if (size == 0) {
+      size = 1;
+   }
+   for (;;) {
+      if (void * p = std::malloc(size)) {
+         return p;
+      }
+      auto handler = std::get_new_handler();
+      if (!handler) {
+         throw std::bad_alloc{};
+      }
+      handler();
+   }
+}
+
+void operator delete(void * p) noexcept {
+   std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept {
+   std::free(p);
+}
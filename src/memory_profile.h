@@ -0,0 +1,60 @@
+#ifndef INCLUDE_LWG_MEMORY_PROFILE_H
+#define INCLUDE_LWG_MEMORY_PROFILE_H
+
+// standard headers
+#include <atomic>
+#include <cstdint>
+
+namespace lwg
+{
+
+// Counts of the memory a program allocates, e.g. for 'lists --memory-profile'.
+//
+// A program that links memory_profile.o has its global 'operator new' replaced by one that
+// counts every allocation once 'start_counting' is called, on any thread. Until then it only
+// tests a flag before calling malloc.
+namespace memory
+{
+
+struct usage {
+   std::uint64_t allocations = 0;  // the number of calls to 'operator new'
+   std::uint64_t bytes = 0;        // the total size requested, including memory already freed
+};
+
+inline auto operator+(usage const & x, usage const & y) noexcept -> usage {
+   return { x.allocations + y.allocations, x.bytes + y.bytes };
+}
+
+inline auto operator-(usage const & x, usage const & y) noexcept -> usage {
+   return { x.allocations - y.allocations, x.bytes - y.bytes };
+}
+
+namespace detail
+{
+inline std::atomic<bool> counting{false};
+inline thread_local usage thread_usage;  // of the calling thread
+}
+
+void start_counting();
+
+inline auto counting() noexcept -> bool {
+   return detail::counting.load(std::memory_order_relaxed);
+}
+
+auto allocated() noexcept -> usage;
+   // Everything allocated since 'start_counting' was called.
+
+inline auto thread_allocated() noexcept -> usage {
+   return detail::thread_usage;
+}
+   // Everything the calling thread allocated since 'start_counting' was called. This is always
+   // zero in a program that does not link memory_profile.o.
+
+auto peak_rss() noexcept -> std::uintmax_t;
+   // The most physical memory the process has used so far, in bytes, or zero if it is not known.
+
+} // close namespace memory
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_MEMORY_PROFILE_H
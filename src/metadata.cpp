@@ -1,4 +1,5 @@
 #include "metadata.h"
+#include "mapped_file.h"
 
 #include <fstream>
 #include <iterator>
@@ -33,14 +34,13 @@ namespace {
 
 auto lwg::metadata::read_from_path(std::filesystem::path const& path, bool verbose) -> metadata {
     auto filename = path / "meta-data" / "section.data";
-    std::ifstream infile{filename};
-    if (!infile.is_open()) {
+    if (!std::filesystem::is_regular_file(filename)) {
         throw std::runtime_error{"Can't open section.data at " + path.string() + "meta-data"};
     }
     if (verbose)
       std::cout << "Reading section-tag index from: " << filename << std::endl;
     return {
-        read_section_db(infile),
+        read_section_db(mapped_file{filename}.view()),
         read_git_commit_times(path / "meta-data" / "dates"),
         read_paper_titles(path / "meta-data" / "paper_titles.txt"),
     };
@@ -0,0 +1,83 @@
+#include "page_manifest.h"
+
+#include "mapped_file.h"
+
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+// The first line of the file. Change this whenever the format changes.
+constexpr std::string_view manifest_header = "LWG page manifest 1\n";
+
+} // close unnamed namespace
+
+namespace lwg
+{
+
+auto page_manifest::load(std::filesystem::path const & filename) -> page_manifest {
+   page_manifest manifest;
+   if (!std::filesystem::is_regular_file(filename)) {
+      return manifest;
+   }
+
+   // Each line is a hexadecimal fingerprint, a space, and a filename.
+   mapped_file file{filename};
+   std::string_view data = file.view();
+   if (!data.starts_with(manifest_header)) {
+      return manifest;
+   }
+   data.remove_prefix(manifest_header.size());
+
+   while (!data.empty()) {
+      auto eol = data.find('\n');
+      if (eol == data.npos) {
+         return {};
+      }
+      std::string_view line = data.substr(0, eol);
+      data.remove_prefix(eol + 1);
+
+      std::uint64_t inputs;
+      auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), inputs, 16);
+      if (ec != std::errc{} || ptr == line.data() + line.size() || *ptr != ' ') {
+         return {};
+      }
+      line.remove_prefix(ptr - line.data() + 1);
+      manifest.m_pages.insert_or_assign(std::string{line}, inputs);
+   }
+   return manifest;
+}
+
+void page_manifest::save(std::filesystem::path const & filename) const {
+   std::string out{manifest_header};
+   for (auto const & [page, inputs] : m_pages) {
+      out += std::format("{:016x} {}\n", inputs, page);
+   }
+
+   // Write to a temporary file first, so that an interrupted run cannot
+   // leave a truncated manifest behind.
+   auto tmp = filename;
+   tmp += ".tmp";
+   {
+      std::ofstream f{tmp, std::ios::binary};
+      if (!f.write(out.data(), out.size())) {
+         throw std::runtime_error{"Unable to write page manifest " + tmp.string()};
+      }
+   }
+   std::filesystem::rename(tmp, filename);
+}
+
+auto page_manifest::update(std::string const & page, std::uint64_t inputs) -> bool {
+   auto [it, inserted] = m_pages.try_emplace(page, inputs);
+   if (inserted) {
+      return false;
+   }
+   bool same = it->second == inputs;
+   it->second = inputs;
+   return same;
+}
+
+} // close namespace lwg
@@ -0,0 +1,38 @@
+#ifndef INCLUDE_LWG_PAGE_MANIFEST_H
+#define INCLUDE_LWG_PAGE_MANIFEST_H
+
+// standard headers
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+
+namespace lwg
+{
+
+// Records a fingerprint of the inputs that each generated page was made from,
+// so that a later run can tell which pages in the output directory would be
+// unchanged if they were generated again.
+//
+// The manifest is only meaningful if it describes the pages that are actually
+// in the output directory, so it must be saved after every run that writes
+// pages, not only incremental ones.
+struct page_manifest {
+   static auto load(std::filesystem::path const & filename) -> page_manifest;
+      // Read the manifest written by 'save'. Returns an empty manifest if the
+      // file does not exist or cannot be understood.
+
+   void save(std::filesystem::path const & filename) const;
+      // Write the manifest to 'filename', replacing it atomically.
+
+   auto update(std::string const & page, std::uint64_t inputs) -> bool;
+      // Record 'inputs' as the fingerprint for 'page'.
+      // Returns true if the previous fingerprint for 'page' was the same.
+
+private:
+   std::map<std::string, std::uint64_t> m_pages;
+};
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_PAGE_MANIFEST_H
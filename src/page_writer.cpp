@@ -0,0 +1,194 @@
+#include "page_writer.h"
+
+#include "mapped_file.h"
+#include "parallel.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace lwg
+{
+
+auto same_page(std::string_view old_page, std::string_view new_page, std::span<const volatile_line> volatile_lines) -> bool {
+   if (old_page == new_page) {
+      return true;
+   }
+   if (old_page.size() != new_page.size()) {
+      return false;  // volatile text is only replaced by text of the same length
+   }
+
+   auto same_apart_from_volatile_text = [volatile_lines](std::string_view old_line, std::string_view new_line) {
+      return std::ranges::any_of(volatile_lines, [=](volatile_line const & v) {
+         return new_line.size() == v.before.size() + v.text.size() + v.after.size()
+            and new_line.starts_with(v.before)
+            and new_line.substr(v.before.size()).starts_with(v.text)
+            and new_line.ends_with(v.after)
+            and old_line.size() == new_line.size()
+            and old_line.starts_with(v.before)
+            and old_line.ends_with(v.after);
+      });
+   };
+
+   while (!new_page.empty()) {
+      auto const eol = std::min(new_page.find('\n'), new_page.size());
+      auto const old_line = old_page.substr(0, eol);
+      auto const new_line = new_page.substr(0, eol);
+      if (old_line != new_line && !same_apart_from_volatile_text(old_line, new_line)) {
+         return false;
+      }
+      old_page.remove_prefix(std::min(eol + 1, old_page.size()));
+      new_page.remove_prefix(std::min(eol + 1, new_page.size()));
+   }
+   return true;
+}
+
+auto page_unchanged(std::filesystem::path const & filename, std::string_view contents, std::span<const volatile_line> volatile_lines) -> bool {
+   std::error_code ec;
+   if (!std::filesystem::is_regular_file(filename, ec) || std::filesystem::file_size(filename, ec) != contents.size()) {
+      return false;
+   }
+   mapped_file const file{filename};
+   return same_page(file.view(), contents, volatile_lines);
+}
+
+page_writer::page_writer(bool only_if_changed, std::size_t max_queued)
+   : m_only_if_changed{only_if_changed}
+   , m_max_queued{std::max<std::size_t>(max_queued, 1)}
+   , m_thread{thread_account::charged_to(thread_account::current, [this] { run(); })}
+{
+}
+
+page_writer::~page_writer() {
+   {
+      std::lock_guard lock{m_mutex};
+      m_stop = true;
+   }
+   m_changed.notify_all();
+   // m_thread joins, after writing what is still queued
+}
+
+void page_writer::write(std::filesystem::path filename, std::string contents) {
+   std::unique_lock lock{m_mutex};
+   m_changed.wait(lock, [this] { return m_queue.size() < m_max_queued || m_error; });
+   rethrow_error();
+   m_queue.push_back({std::move(filename), std::move(contents)});
+   m_changed.notify_all();
+}
+
+void page_writer::finish() {
+   std::unique_lock lock{m_mutex};
+   m_changed.wait(lock, [this] { return (m_queue.empty() && !m_busy) || m_error; });
+   rethrow_error();
+}
+
+auto page_writer::files_written() const -> std::size_t {
+   std::lock_guard lock{m_mutex};
+   return m_files;
+}
+
+auto page_writer::bytes_written() const -> std::uintmax_t {
+   std::lock_guard lock{m_mutex};
+   return m_bytes;
+}
+
+auto page_writer::files_unchanged() const -> std::size_t {
+   std::lock_guard lock{m_mutex};
+   return m_unchanged;
+}
+
+void page_writer::rethrow_error() {
+   if (m_error) {
+      std::rethrow_exception(m_error);
+   }
+}
+
+void page_writer::run() {
+   std::unique_lock lock{m_mutex};
+   for (;;) {
+      m_changed.wait(lock, [this] { return !m_queue.empty() || m_stop; });
+      if (m_queue.empty() || m_error) {
+         return;
+      }
+      page p = std::move(m_queue.front());
+      m_queue.pop_front();
+      m_busy = true;
+      m_changed.notify_all();  // there is room in the queue
+      lock.unlock();
+
+      std::exception_ptr error;
+      bool unchanged = false;
+      try {
+         trace_span span{"write", p.filename};
+         unchanged = m_only_if_changed && page_unchanged(p.filename, p.contents);
+         if (!unchanged) {
+            std::ofstream out;
+            out.rdbuf()->pubsetbuf(nullptr, 0);  // the whole page is written at once, so do not copy it into a buffer
+            out.open(p.filename);
+            if (!out)
+               throw std::runtime_error{"Failed to open " + p.filename.string()};
+            out.write(p.contents.data(), p.contents.size());
+            out.close();
+            if (!out)
+               throw std::runtime_error{"Failed to write " + p.filename.string()};
+         }
+      }
+      catch (...) {
+         error = std::current_exception();
+      }
+
+      lock.lock();
+      m_busy = false;
+      if (error) {
+         m_error = error;
+         m_queue.clear();
+      }
+      else if (unchanged) {
+         ++m_unchanged;
+      }
+      else {
+         ++m_files;
+         m_bytes += p.contents.size();
+      }
+      m_changed.notify_all();
+   }
+}
+
+} // close namespace lwg
+
+#ifdef SELF_TEST
+#include <cassert>
+int main()
+{
+   lwg::volatile_line const dated[] = {
+      { "<p>Revised ", "2026-10-17", "</p>" },
+   };
+   std::string_view const page = "<h1>Issues</h1>\n<p>Revised 2026-10-17</p>\n<p>Opened 2026-10-17</p>\n";
+
+   assert(lwg::same_page(page, page));
+   assert(lwg::same_page(page, page, dated));
+
+   // A page that only differs in the date on a volatile line is unchanged, and is kept:
+   assert(lwg::same_page("<h1>Issues</h1>\n<p>Revised 2026-09-30</p>\n<p>Opened 2026-10-17</p>\n", page, dated));
+   assert(not lwg::same_page("<h1>Issues</h1>\n<p>Revised 2026-09-30</p>\n<p>Opened 2026-10-17</p>\n", page));
+
+   // The same date anywhere else in the page is not ignored:
+   assert(not lwg::same_page("<h1>Issues</h1>\n<p>Revised 2026-10-17</p>\n<p>Opened 2026-09-30</p>\n", page, dated));
+   assert(not lwg::same_page("<h1>Issues</h1>\n<p>Revised 2026-09-30</p>\n<p>Opened 2026-09-30</p>\n", page, dated));
+   assert(not lwg::same_page("<h1>Issues</h1>\n<p>Edited 2026-09-30</p>\n<p>Opened 2026-10-17</p>\n", page, dated));
+
+   // Pages of different lengths are different, even if one is a prefix of the other:
+   assert(not lwg::same_page("<h1>Issues</h1>\n<p>Revised 2026-10-17</p>\n", page, dated));
+   assert(not lwg::same_page(page, "<h1>Issues</h1>\n<p>Revised 2026-10-17</p>\n", dated));
+   assert(not lwg::same_page("<h1>Issues</h1>\n<p>Revised 2026-9-30</p>\n<p>Opened 2026-10-17</p>\n", page, dated));
+   assert(not lwg::same_page("", page, dated));
+
+   // The last line need not end with a newline:
+   assert(lwg::same_page("<h1>Issues</h1>\n<p>Revised 2026-09-30</p>", "<h1>Issues</h1>\n<p>Revised 2026-10-17</p>", dated));
+   assert(not lwg::same_page("<h1>Issues</h1>\n<p>Edited 2026-09-30</p>", "<h1>Issues</h1>\n<p>Revised 2026-10-17</p>", dated));
+   assert(not lwg::same_page("<h1>Issues</h1>\n<p>Revised 2026-09-30</p>\n", "<h1>Issues</h1>\n<p>Revised 2026-10-17</p>", dated));
+   assert(not lwg::same_page("<h1>Issues</h1>\n<p>Revised 2026-09-30</p>\n", "<h1>Issues</h1>\n\n<p>Revised 2026-10-17</p>", dated));
+}
+#endif
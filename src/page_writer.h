@@ -0,0 +1,89 @@
+#ifndef INCLUDE_LWG_PAGE_WRITER_H
+#define INCLUDE_LWG_PAGE_WRITER_H
+
+// standard headers
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace lwg
+{
+
+// A line of a page that differs between builds that have the same inputs, such as the
+// date the page was made.
+struct volatile_line {
+   std::string_view before;  // the start of the line, which is always the same
+   std::string_view text;    // the text that differs, e.g. "2026-10-17"
+   std::string_view after;   // the end of the line, which is always the same
+};
+
+auto same_page(std::string_view old_page, std::string_view new_page, std::span<const volatile_line> volatile_lines = {}) -> bool;
+   // True if 'new_page' is the same as 'old_page', apart from lines of 'new_page' that are
+   // exactly one of 'volatile_lines' where 'old_page' has a line with the same 'before' and
+   // 'after', and other text of the same length in between.
+
+auto page_unchanged(std::filesystem::path const & filename, std::string_view contents, std::span<const volatile_line> volatile_lines = {}) -> bool;
+   // True if 'filename' exists and is the 'same_page' as 'contents'.
+
+
+// Writes pages that have already been formatted in memory, each with a single write,
+// on a dedicated thread. Any number of threads may hand it pages concurrently.
+//
+// At most 'max_queued' pages wait to be written, so that formatting cannot get
+// arbitrarily far ahead of the disk: 'write' blocks while the queue is full.
+//
+// If 'only_if_changed' is true, a page is not written if the file already has the same contents.
+//
+// If writing a page fails, no more pages are written and the error is rethrown by
+// the next call to 'write' or 'finish'.
+struct page_writer {
+   explicit page_writer(bool only_if_changed = false, std::size_t max_queued = 64);
+   ~page_writer();
+
+   page_writer(page_writer const &) = delete;
+   page_writer & operator=(page_writer const &) = delete;
+
+   void write(std::filesystem::path filename, std::string contents);
+      // Queue 'contents' to be written to 'filename', replacing any existing file.
+
+   void finish();
+      // Wait until every queued page has been written.
+
+   auto files_written() const -> std::size_t;
+   auto bytes_written() const -> std::uintmax_t;
+   auto files_unchanged() const -> std::size_t;
+
+private:
+   struct page {
+      std::filesystem::path filename;
+      std::string           contents;
+   };
+
+   void run();
+   void rethrow_error();  // the caller must hold 'm_mutex'
+
+   bool const                   m_only_if_changed;
+   std::size_t const            m_max_queued;
+   mutable std::mutex           m_mutex;
+   std::condition_variable      m_changed;
+   std::deque<page>             m_queue;
+   bool                         m_busy = false;  // the writer thread is writing a page
+   bool                         m_stop = false;
+   std::exception_ptr           m_error;
+   std::size_t                  m_files = 0;
+   std::uintmax_t               m_bytes = 0;
+   std::size_t                  m_unchanged = 0;
+   std::jthread                 m_thread;        // last, so it starts after everything it uses
+};
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_PAGE_WRITER_H
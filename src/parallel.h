@@ -0,0 +1,266 @@
+#ifndef INCLUDE_LWG_PARALLEL_H
+#define INCLUDE_LWG_PARALLEL_H
+
+// solution specific headers
+#include "memory_profile.h"
+
+// standard headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <queue>
+#include <semaphore>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lwg
+{
+
+// The number of worker threads to use when none is requested explicitly.
+inline auto default_jobs() -> unsigned {
+   return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// The CPU time used so far by the calling thread, or by the whole process where that is not available.
+inline auto thread_cpu_time() -> std::chrono::nanoseconds {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+   timespec ts;
+   clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+   return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+#else
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(double(std::clock()) / CLOCKS_PER_SEC));
+#endif
+}
+
+// What the threads that were started on behalf of some work used, e.g. for a stage being timed.
+// While a thread's 'current' account is set, each thread that 'parallel_for' or 'page_writer' starts
+// from it uses the same account, and adds its CPU time and allocations to it when it finishes.
+struct thread_account {
+   std::atomic<std::int64_t>  cpu{0};          // nanoseconds
+   std::atomic<std::uint64_t> allocations{0};  // see 'memory::thread_allocated'
+   std::atomic<std::uint64_t> bytes{0};
+
+   static inline thread_local thread_account * current = nullptr;
+
+   // Run 'f' in a thread charged to 'account', which may be null.
+   template<typename Func>
+   static auto charged_to(thread_account * account, Func f) {
+      return [account, f = std::move(f)]() mutable {
+         current = account;
+         f();
+         if (account) {
+            auto const allocated = memory::thread_allocated();
+            account->cpu += thread_cpu_time().count();
+            account->allocations += allocated.allocations;
+            account->bytes += allocated.bytes;
+         }
+      };
+   }
+};
+
+// The number of threads that may be working at once, shared by a 'task_graph' and any
+// 'parallel_for' loops in its tasks, so that a loop in a task only uses the threads that
+// other tasks leave free. Each thread working on a task or a loop holds one job.
+class job_budget {
+public:
+   explicit job_budget(unsigned jobs) : m_free{std::max(jobs, 1u)} { }
+
+   void acquire() { m_free.acquire(); }
+   auto try_acquire() -> bool { return m_free.try_acquire(); }
+   void release(std::ptrdiff_t jobs = 1) { if (jobs != 0) m_free.release(jobs); }
+
+   // The budget of the task the calling thread is working on, if any.
+   static inline thread_local job_budget * current = nullptr;
+
+private:
+   std::counting_semaphore<> m_free;
+};
+
+// Call 'f(i)' for every 'i' in [0, n), using up to 'jobs' threads.
+// Indices are handed out in increasing order, so if any call throws then no
+// further indices are started, and the exception thrown for the lowest index
+// is rethrown once all threads have finished. This means the caller sees the
+// same error as a sequential loop would have reported.
+//
+// Inside a task of a 'task_graph', another thread is only started when the graph's
+// 'job_budget' has a job free, which is checked again before each call to 'f', so
+// the loop uses more threads as other tasks finish.
+template<typename Func>
+void parallel_for(std::size_t n, unsigned jobs, Func f) {
+   std::vector<std::exception_ptr> errors(n);
+   std::atomic<std::size_t> next{0};
+   std::atomic<bool> failed{false};
+
+   auto * const budget = job_budget::current;
+   auto * const account = thread_account::current;
+   std::size_t const max_threads = std::min<std::size_t>(jobs, n);
+   std::vector<std::jthread> threads;
+
+   // 'start_helpers' is called before each call to 'f' on the calling thread, which is the only
+   // thread that starts others.
+   auto worker = [&](auto start_helpers) {
+      for (std::size_t i; !failed && (i = next++) < n; ) {
+         start_helpers();
+         try {
+            f(i);
+         }
+         catch (...) {
+            errors[i] = std::current_exception();
+            failed = true;
+         }
+      }
+   };
+
+   auto start_helpers = [&] {
+      while (threads.size() + 1 < max_threads && (!budget || budget->try_acquire())) {
+         threads.emplace_back(thread_account::charged_to(account, [&worker, budget] {
+            job_budget::current = budget;
+            worker([] { });
+         }));
+      }
+   };
+
+   worker(start_helpers);
+   auto const helpers = threads.size();
+   threads.clear();  // join
+   if (budget) {
+      budget->release(helpers);
+   }
+
+   for (auto const & e : errors) {
+      if (e) {
+         std::rethrow_exception(e);
+      }
+   }
+}
+
+// A set of tasks, each of which may only start once the tasks it depends on have finished.
+// A task can only depend on tasks that were added before it, so adding the tasks in the
+// order that a sequential program would perform them always gives a valid graph.
+//
+// When run with several threads, the ready task that was added first is always started next,
+// so with one thread the tasks run in the order they were added. If a task throws, no task
+// added after it is started, any task added before it still runs, and the exception from the
+// first task to be added of those that threw is rethrown once all running tasks have finished.
+// Again the caller sees the same error as a sequential program would have reported.
+//
+// At most 'jobs' threads work on the tasks at once, including the threads of any 'parallel_for'
+// loops in the tasks, see 'job_budget'.
+class task_graph {
+public:
+   using task_id = std::size_t;
+
+   auto add(std::function<void()> f, std::initializer_list<task_id> dependencies = {}) -> task_id {
+      task_id const id = m_tasks.size();
+      std::size_t waiting_for = 0;
+      for (task_id dep : dependencies) {
+         if (dep >= id) {
+            throw std::logic_error{"a task can only depend on tasks added before it"};
+         }
+         m_tasks[dep].dependents.push_back(id);
+         ++waiting_for;
+      }
+      m_tasks.push_back({std::move(f), {}, waiting_for});
+      return id;
+   }
+
+   void run(unsigned jobs) {
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::priority_queue<task_id, std::vector<task_id>, std::greater<>> ready;
+      std::vector<std::exception_ptr> errors(m_tasks.size());
+      task_id first_failure = m_tasks.size();
+      std::size_t running = 0;
+
+      for (task_id id = 0; id != m_tasks.size(); ++id) {
+         if (m_tasks[id].waiting_for == 0) {
+            ready.push(id);
+         }
+      }
+
+      // Loops in the tasks share the jobs with the tasks, see 'parallel_for'.
+      job_budget budget{jobs};
+
+      auto worker = [&] {
+         auto * const outer_budget = std::exchange(job_budget::current, &budget);
+         std::unique_lock lock{mutex};
+         for (;;) {
+            cv.wait(lock, [&] { return !ready.empty() or running == 0; });
+            if (ready.empty()) {
+               job_budget::current = outer_budget;
+               return;  // nothing is ready or running, so nothing more can become ready
+            }
+            task_id const id = ready.top();
+            ready.pop();
+            if (id > first_failure) {
+               continue;
+            }
+
+            ++running;
+            lock.unlock();
+            std::exception_ptr error;
+            budget.acquire();
+            try {
+               m_tasks[id].f();
+            }
+            catch (...) {
+               error = std::current_exception();
+            }
+            budget.release();
+            lock.lock();
+            --running;
+
+            if (error) {
+               errors[id] = error;
+               first_failure = std::min(first_failure, id);
+            }
+            else {
+               for (task_id next : m_tasks[id].dependents) {
+                  if (--m_tasks[next].waiting_for == 0) {
+                     ready.push(next);
+                  }
+               }
+            }
+            cv.notify_all();
+         }
+      };
+
+      {
+         std::vector<std::jthread> threads;
+         for (std::size_t t = 1; t < std::min<std::size_t>(jobs, m_tasks.size()); ++t) {
+            threads.emplace_back(worker);
+         }
+         worker();
+      } // join
+
+      m_tasks.clear();
+      for (auto const & e : errors) {
+         if (e) {
+            std::rethrow_exception(e);
+         }
+      }
+   }
+
+private:
+   struct task {
+      std::function<void()> f;
+      std::vector<task_id>  dependents;
+      std::size_t           waiting_for;
+   };
+
+   std::vector<task> m_tasks;
+};
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_PARALLEL_H
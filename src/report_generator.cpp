@@ -4,9 +4,15 @@
 
 #include "report_generator.h"
 
+#include "fingerprint.h"
+#include "issue_profile.h"
 #include "mailing_info.h"
+#include "page_manifest.h"
+#include "page_writer.h"
+#include "parallel.h"
 #include "sections.h"
 #include "html_utils.h"
+#include "trace.h"
 
 #include <algorithm>
 #include <cassert>
@@ -15,6 +21,7 @@
 #include <format>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <tuple>
@@ -47,36 +54,66 @@ std::string const maintainer_name{"Jonathan Wakely"};
 
 std::string const is14882_docno{"ISO/IEC IS 14882:2024(E)"};
 
-struct order_by_first_tag {
-   bool operator()(lwg::issue const & x, lwg::issue const & y) const noexcept {
-      assert(!x.tags.empty());
-      assert(!y.tags.empty());
-      return x.tags.front() < y.tags.front();
+// Increase this whenever a change to the code alters the generated HTML,
+// so that an incremental run does not keep pages made by the old code.
+constexpr int output_format_version = 1;
+
+// A fingerprint of everything about an issue that can appear in a page.
+// This includes the section numbers for its tags, and the formatted text,
+// which already contains the titles and status of any issues it refers to.
+auto issue_inputs(lwg::issue const & iss, lwg::section_registry const & sections) -> std::uint64_t {
+   lwg::fingerprint fp;
+   fp.add(iss.num).add(lwg::as_string(iss.stat)).add(iss.title).add(iss.doc_prefix);
+   fp.add(iss.sections.size());
+   for (auto id : iss.sections) {
+      auto const & tag = sections.tag(id);
+      auto const & num = sections.num(id);
+      fp.add(tag.prefix).add(tag.name);
+      fp.add(num.prefix).add(num.num.size());
+      for (int n : num.num) {
+         fp.add(n);
+      }
    }
-};
+   fp.add(iss.submitter);
+   for (auto date : { iss.date, iss.mod_date }) {
+      fp.add(int(date.year())).add(unsigned(date.month())).add(unsigned(date.day()));
+   }
+   fp.add(iss.duplicates.size());
+   for (auto const & dup : iss.duplicates) {
+      fp.add(dup);
+   }
+   fp.add(iss.text).add(iss.priority).add(iss.owner).add(iss.resolution).add(iss.has_resolution);
+   return fp.value();
+}
 
 // Similar to lwg::section_num but only looks at the first num in e.g. 17.5.2
 using major_section_key = std::pair<std::string_view, int>;
 
 // Find key for major section (i.e. Clause number, within a given IS or TS)
-auto lookup_major_section(lwg::section_map& db, const lwg::issue& i) -> major_section_key {
-   assert(!i.tags.empty());
-   const lwg::section_num& sect = db[i.tags[0]];
+auto lookup_major_section(lwg::section_registry const & sections, const lwg::issue& i) -> major_section_key {
+   assert(!i.sections.empty());
+   const lwg::section_num& sect = sections.num(i.sections[0]);
    return { sect.prefix, sect.num[0] };
 }
 
+// Create a LessThanComparable object that orders issues by major section.
+auto ordered_major_section(lwg::section_registry const & sections, lwg::issue const & issue) {
+   assert(!issue.sections.empty());
+   return sections.major_order(issue.sections.front());
+}
+
 struct order_by_major_section {
-   explicit order_by_major_section(lwg::section_map & sections)
-      : section_db(sections)
+   explicit order_by_major_section(lwg::section_registry const & sections)
+      : sections(sections)
       {
       }
 
    auto operator()(lwg::issue const & x, lwg::issue const & y) const -> bool {
-      return lookup_major_section(section_db, x) < lookup_major_section(section_db, y);
+      return ordered_major_section(sections, x) < ordered_major_section(sections, y);
    }
 
 private:
-   lwg::section_map& section_db;
+   lwg::section_registry const & sections;
 };
 
 // Create a LessThanComparable object that defines an ordering based on date,
@@ -91,35 +128,23 @@ auto ordered_date(lwg::issue const & issue) {
 // Using both is not redundant, because we use section 99 for all sections of some TS's.
 // Including the tag in the order gives a total order for sections in those TS's,
 // e.g., {99,[arrays.ts::dynarray]} < {99,[arrays.ts::dynarraconstructible_from.cons]}.
-auto ordered_section(lwg::section_map & section_db, lwg::issue const & issue) {
-   assert(!issue.tags.empty());
-   return std::tie(section_db[issue.tags.front()], issue.tags.front());
+auto ordered_section(lwg::section_registry const & sections, lwg::issue const & issue) {
+   assert(!issue.sections.empty());
+   return sections.order_by_num_then_tag(issue.sections.front());
 }
 
 struct order_by_section {
-   explicit order_by_section(lwg::section_map &sections)
-      : section_db(sections)
+   explicit order_by_section(lwg::section_registry const & sections)
+      : sections(sections)
       {
       }
 
    auto operator()(lwg::issue const & x, lwg::issue const & y) const -> bool {
-      return ordered_section(section_db, x) < ordered_section(section_db, y);
+      return ordered_section(sections, x) < ordered_section(sections, y);
    }
 
 private:
-   lwg::section_map& section_db;
-};
-
-struct order_by_status {
-   auto operator()(lwg::issue const & x, lwg::issue const & y) const noexcept -> bool {
-      return lwg::get_status_priority(x.stat) < lwg::get_status_priority(y.stat);
-   }
-   auto operator()(lwg::issue const & x, std::string_view y) const noexcept -> bool {
-      return lwg::get_status_priority(x.stat) < lwg::get_status_priority(y);
-   }
-   auto operator()(std::string_view x, lwg::issue const & y) const noexcept -> bool {
-      return lwg::get_status_priority(x) < lwg::get_status_priority(y.stat);
-   }
+   lwg::section_registry const & sections;
 };
 
 
@@ -238,110 +263,72 @@ void print_file_trailer(std::ostream& out) {
 }
 
 
-void print_table(std::ostream& out, std::span<const lwg::issue> issues, lwg::section_map& section_db, bool link_stable_names = false) {
-#if defined (DEBUG_LOGGING)
-   std::cout << "\t" << issues.size() << " items to add to table" << std::endl;
-#endif
-
-   out <<
-R"(<table class="issues-index">
-<tr>
-  <th><a href="lwg-toc.html">Issue</a></th>
-  <th><a href="lwg-status.html">Status</a></th>
-  <th><a href="lwg-index.html">Section</a></th>
-  <th>Title</th>
-  <th>Proposed Resolution</th>
-  <th><a href="unresolved-prioritized.html">Priority</a></th>
-  <th>Duplicates</th>
-</tr>
-)";
-
-   lwg::section_tag prev_tag;
-   for (auto& i : issues) {
-      out << "<tr>\n";
-
-      // Number
-      out << "<td id=\"" << i.num << "\">" << make_html_anchor(i) << "</td>\n";
-
-      // Status
-      const auto status_idattr = spaces_to_underscores(std::string(lwg::remove_qualifier(i.stat)));
-      out << "<td><a href=\"lwg-active.html#" << status_idattr << "\">" << i.stat << "</a></td>\n";
-
-      // Section
-      out << "<td>";
-      assert(!i.tags.empty());
-      out << section_db[i.tags[0]] << " " << i.tags[0];
-      if (link_stable_names && i.tags[0] != prev_tag) {
-         prev_tag = i.tags[0];
-         out << "<a id=\"" << as_string(prev_tag) << "\"></a>";
-      }
-      out << "</td>\n";
-
-      // Title
-      out << "<td>" << i.title << "</td>\n";
+// The row of the index tables for an issue, which is the same in every table.
+auto render_table_row(lwg::issue const & i, lwg::section_registry const & sections) -> lwg::table_row {
+   std::ostringstream out;
+   out << "<tr>\n";
+
+   // Number
+   out << "<td id=\"" << i.num << "\">" << make_html_anchor(i) << "</td>\n";
+
+   // Status
+   const auto status_idattr = spaces_to_underscores(std::string(lwg::remove_qualifier(i.stat)));
+   out << "<td><a href=\"lwg-active.html#" << status_idattr << "\">" << i.stat << "</a></td>\n";
+
+   // Section
+   out << "<td>";
+   assert(!i.sections.empty());
+   auto const section = i.sections[0];
+   out << sections.num(section) << " " << sections.tag(section);
+   auto const anchor_pos = static_cast<std::size_t>(out.tellp());
+   out << "</td>\n";
+
+   // Title
+   out << "<td>" << i.title << "</td>\n";
+
+   // Has Proposed Resolution
+   out << "<td>";
+   if (i.has_resolution) {
+      out << "Yes";
+   }
+   else {
+      out << "<span class=\"no-pr\">No</span>";
+   }
+   out << "</td>\n";
 
-      // Has Proposed Resolution
-      out << "<td>";
-      if (i.has_resolution) {
-         out << "Yes";
-      }
-      else {
-         out << "<span class=\"no-pr\">No</span>";
-      }
-      out << "</td>\n";
+   // Priority
+   out << "<td>";
+   if (i.priority != 99) {
+      out << i.priority;
+   }
+   out << "</td>\n";
 
-      // Priority
-      out << "<td>";
-      if (i.priority != 99) {
-         out << i.priority;
-      }
-      out << "</td>\n";
+   // Duplicates
+   out << "<td>";
+   print_list(out, i.duplicates, ", ");
+   out << "</td>\n"
+       << "</tr>\n";
 
-      // Duplicates
-      out << "<td>";
-      print_list(out, i.duplicates, ", ");
-      out << "</td>\n"
-          << "</tr>\n";
-   }
-   out << "</table>\n";
+   return { std::move(out).str(), anchor_pos };
 }
 
 enum class print_issue_type { in_list, individual };
 
-using issue_set_by_first_tag = std::multiset<lwg::issue, order_by_first_tag>;
-using issue_set_by_status    = std::multiset<lwg::issue, order_by_status>;
-
-void print_issue(std::ostream & out, lwg::issue const & iss, lwg::section_map & section_db,
-                 issue_set_by_first_tag const & all_issues, issue_set_by_status const & issues_by_status,
-                 issue_set_by_first_tag const & active_issues, print_issue_type type = print_issue_type::in_list) {
-         out << "<hr>\n";
+// Everything that is printed for an issue after its number. This is the same in every
+// document, so it is rendered once per issue and reused, see 'report_generator::bodies_for'.
+auto render_issue_body(lwg::issue const & iss, lwg::section_registry const & sections, lwg::issue_counts const & counts) -> std::string {
+         std::ostringstream out;
 
          const auto status_idattr = spaces_to_underscores(std::string(lwg::remove_qualifier(iss.stat)));
 
-         // Number
-
-         // When printing for the list, also emit an absolute link to the individual file.
-         // Absolute link so that copying only the big lists elsewhere doesn't result in broken links.
-         if (type == print_issue_type::in_list) {
-              out << "<h3 id=\"" << iss.num << "\"><a href=\"" << iss.num << "\">" << iss.num << "</a>";
-         }
-         else {
-              out << "<p><em>This page is a snapshot from the LWG issues list, see the "
-                     "<a href=\"lwg-active.html\">Library Active Issues List</a> "
-                     "for more information and the meaning of "
-                     "<a href=\"lwg-active.html#" << status_idattr << "\">"
-                  << iss.stat << "</a> status.</em></p>\n";
-              out << "<h3 id=\"" << iss.num << "\"><a href=\"" << lwg::filename_for_status(iss.stat) << '#' << iss.num << "\">" << iss.num << "</a>";
-         }
-
          // Title
          out << ". " << iss.title << "</h3>\n";
 
          // Section, Status, Submitter, Date
          out << "<p><b>Section:</b> ";
-         out << lwg::format_section_tag_as_link(section_db, iss.tags[0]);
-         for (unsigned k = 1; k < iss.tags.size(); ++k) {
-            out << ", " << lwg::format_section_tag_as_link(section_db, iss.tags[k]);
+         out << sections.link(iss.sections[0]);
+         for (unsigned k = 1; k < iss.sections.size(); ++k) {
+            out << ", " << sections.link(iss.sections[k]);
          }
 
          out << " <b>Status:</b> <a href=\"lwg-active.html#" << status_idattr << "\">" << iss.stat << "</a>\n";
@@ -359,18 +346,18 @@ void print_issue(std::ostream & out, lwg::issue const & iss, lwg::section_map &
          out << "</p>\n";
 
          // view active issues in []
-         if (active_issues.count(iss) > 1) {
+         if (counts.others_active_in_section(iss)) {
             out << "<p><b>View other</b> <a href=\"lwg-index-open.html#"
               << as_string(iss.tags[0]) << "\">active issues</a> in " << iss.tags[0] << ".</p>\n";
          }
 
          // view all issues in []
-         if (all_issues.count(iss) > 1) {
+         if (counts.others_in_section(iss)) {
             out << "<p><b>View all other</b> <a href=\"lwg-index.html#"
               << as_string(iss.tags[0]) << "\">issues</a> in " << iss.tags[0] << ".</p>\n";
          }
          // view all issues with same status
-         if (issues_by_status.count(iss) > 1) {
+         if (counts.others_with_status(iss)) {
             out << "<p><b>View all issues with</b> <a href=\"lwg-status.html#" << iss.stat << "\">" << iss.stat << "</a> status.</p>\n";
          }
 
@@ -384,41 +371,69 @@ void print_issue(std::ostream & out, lwg::issue const & iss, lwg::section_map &
          // text
          out << iss.text << "\n\n";
 
+         return std::move(out).str();
 }
 
-template <typename Pred>
-void print_issues(std::ostream & out, std::span<const lwg::issue> issues, lwg::section_map & section_db, Pred pred) {
-   issue_set_by_first_tag const  all_issues{ issues.begin(), issues.end()} ;
-   issue_set_by_status    const  issues_by_status{ issues.begin(), issues.end() };
+void print_issue(std::ostream & out, lwg::issue const & iss, std::string_view body, print_issue_type type = print_issue_type::in_list) {
+         out << "<hr>\n";
 
-   issue_set_by_first_tag active_issues;
-   for (auto const & elem : issues) {
-      if (lwg::is_active(elem.stat)) {
-         active_issues.insert(elem);
-      }
-   }
+         // Number
 
-   for (auto const & iss : issues) {
-      if (pred(iss)) {
-          print_issue(out, iss, section_db, all_issues, issues_by_status, active_issues);
+         // When printing for the list, also emit an absolute link to the individual file.
+         // Absolute link so that copying only the big lists elsewhere doesn't result in broken links.
+         if (type == print_issue_type::in_list) {
+              out << "<h3 id=\"" << iss.num << "\"><a href=\"" << iss.num << "\">" << iss.num << "</a>";
+         }
+         else {
+              const auto status_idattr = spaces_to_underscores(std::string(lwg::remove_qualifier(iss.stat)));
+              out << "<p><em>This page is a snapshot from the LWG issues list, see the "
+                     "<a href=\"lwg-active.html\">Library Active Issues List</a> "
+                     "for more information and the meaning of "
+                     "<a href=\"lwg-active.html#" << status_idattr << "\">"
+                  << iss.stat << "</a> status.</em></p>\n";
+              out << "<h3 id=\"" << iss.num << "\"><a href=\"" << lwg::filename_for_status(iss.stat) << '#' << iss.num << "\">" << iss.num << "</a>";
+         }
+
+         out << body;
+}
+
+// The individual page for 'iss', given the HTML for the issue after its number.
+auto format_issue_page(lwg::issue const & iss, std::string_view body) -> std::string {
+   auto num = std::to_string(iss.num);
+   std::ostringstream out;
+   print_file_header(out, "Issue " + num + ": " + lwg::strip_xml_elements(iss.title),
+         // XXX should we use e.g. lwg-active.html#num as the canonical URL for the issue?
+         num + ".html",
+         "C++ library issue. Status: " + std::string(as_string(iss.stat)));
+   print_issue(out, iss, body, print_issue_type::individual);
+   print_file_trailer(out);
+   return std::move(out).str();
+}
+
+template <typename Pred>
+void print_issues(std::ostream & out, std::span<const lwg::issue> issues, std::span<const std::string> bodies, Pred pred) {
+   assert(issues.size() == bodies.size());
+   for (std::size_t i = 0; i != issues.size(); ++i) {
+      if (pred(issues[i])) {
+          print_issue(out, issues[i], bodies[i]);
       }
    }
 }
 
 template <typename Pred>
-void print_resolutions(std::ostream & out, std::span<const lwg::issue> issues, lwg::section_map & section_db, Pred predicate) {
+void print_resolutions(std::ostream & out, std::span<const lwg::issue> issues, lwg::section_registry const & sections, Pred predicate) {
    // This construction calls out for filter-iterators
 //   std::multiset<lwg::issue, order_by_first_tag> pending_issues;
-   std::vector<lwg::issue> pending_issues;
+   std::vector<lwg::issue_ref> pending_issues;
    for (auto const & elem : issues) {
       if (predicate(elem)) {
          pending_issues.emplace_back(elem);
       }
    }
 
-   sort(begin(pending_issues), end(pending_issues), order_by_section{section_db});
+   sort(begin(pending_issues), end(pending_issues), order_by_section{sections});
 
-   for (auto const & iss : pending_issues) {
+   for (lwg::issue const & iss : pending_issues) {
       if (predicate(iss)) {
          out << "<hr>\n"
 
@@ -472,6 +487,21 @@ R"(<table>
 namespace lwg
 {
 
+issue_counts::issue_counts(std::span<const issue> issues, section_registry const & sections)
+   : in_section(sections.size())
+   , active_in_section(sections.size())
+{
+   for (auto const & iss : issues) {
+      assert(!iss.sections.empty());
+      auto const section = iss.sections.front();
+      ++in_section[section];
+      if (is_active(iss.stat)) {
+         ++active_in_section[section];
+      }
+      ++with_status[static_cast<std::size_t>(iss.stat)];
+   }
+}
+
 // Functions to make the 3 standard published issues list documents
 // A precondition for calling any of these functions is that the list of issues is sorted in numerical order, by issue number.
 // While nothing disastrous will happen if this precondition is violated, the published issues list will list items
@@ -480,9 +510,10 @@ void report_generator::make_active(std::span<const issue> issues, fs::path const
    assert(std::ranges::is_sorted(issues, {}, &issue::num));
 
    fs::path filename{path / "lwg-active.html"};
-   std::ofstream out{filename};
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues, diff_report)) {
+      return;
+   }
+   std::ostringstream out;
    print_file_header(out, "C++ Standard Library Active Issues List", filename.filename().string(),
          "Unresolved issues in the C++ Standard Library");
    print_paper_heading(out, "active", lwg_issues_xml);
@@ -490,8 +521,9 @@ void report_generator::make_active(std::span<const issue> issues, fs::path const
    out << "<h2 id='History'>Revision History</h2>\n" << lwg_issues_xml.get_revisions(issues, diff_report) << '\n';
    out << "<h2 id='Status'>Issue Status</h2>\n" << lwg_issues_xml.get_statuses() << '\n';
    out << "<h2 id='Issues'>Active Issues</h2>\n";
-   print_issues(out, issues, section_db, [](issue const & i) {return is_active(i.stat);} );
+   print_issues(out, issues, bodies_for(issues), [](issue const & i) {return is_active(i.stat);} );
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 
@@ -499,17 +531,19 @@ void report_generator::make_defect(std::span<const issue> issues, fs::path const
    assert(std::ranges::is_sorted(issues, {}, &issue::num));
 
    fs::path filename{path / "lwg-defects.html"};
-   std::ofstream out(filename);
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues, diff_report)) {
+      return;
+   }
+   std::ostringstream out;
    print_file_header(out, "C++ Standard Library Defect Reports and Accepted Issues", filename.filename().string(),
          "Resolved issues in the C++ Standard Library");
    print_paper_heading(out, "defect", lwg_issues_xml);
    out << lwg_issues_xml.get_intro("defect") << '\n';
    out << "<h2 id='History'>Revision History</h2>\n" << lwg_issues_xml.get_revisions(issues, diff_report) << '\n';
    out << "<h2 id='Issues'>Accepted Issues</h2>\n";
-   print_issues(out, issues, section_db, [](issue const & i) {return is_defect(i.stat);} );
+   print_issues(out, issues, bodies_for(issues), [](issue const & i) {return is_defect(i.stat);} );
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 
@@ -517,17 +551,19 @@ void report_generator::make_closed(std::span<const issue> issues, fs::path const
    assert(std::ranges::is_sorted(issues, {}, &issue::num));
 
    fs::path filename{path / "lwg-closed.html"};
-   std::ofstream out{filename};
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues, diff_report)) {
+      return;
+   }
+   std::ostringstream out;
    print_file_header(out, "C++ Standard Library Closed Issues List", filename.filename().string(),
          "Rejected C++ standard library issues");
    print_paper_heading(out, "closed", lwg_issues_xml);
    out << lwg_issues_xml.get_intro("closed") << '\n';
    out << "<h2 id='History'>Revision History</h2>\n" << lwg_issues_xml.get_revisions(issues, diff_report) << '\n';
    out << "<h2 id='Issues'>Closed Issues</h2>\n";
-   print_issues(out, issues, section_db, [](issue const & i) {return is_closed(i.stat);} );
+   print_issues(out, issues, bodies_for(issues), [](issue const & i) {return is_closed(i.stat);} );
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 
@@ -537,9 +573,10 @@ void report_generator::make_tentative(std::span<const issue> issues, fs::path co
    assert(std::ranges::is_sorted(issues, {}, &issue::num));
 
    fs::path filename{path / "lwg-tentative.html"};
-   std::ofstream out{filename};
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues)) {
+      return;
+   }
+   std::ostringstream out;
    print_file_header(out, "C++ Standard Library Tentative Issues");
 //   print_paper_heading(out, "active", lwg_issues_xml);
 //   out << lwg_issues_xml.get_intro("active") << '\n';
@@ -547,8 +584,9 @@ void report_generator::make_tentative(std::span<const issue> issues, fs::path co
 //   out << "<h2 id='Status'>Issue Status</h2>\n" << lwg_issues_xml.get_statuses() << '\n';
    out << "<p>" << build_timestamp << "</p>";
    out << "<h2>Tentative Issues</h2>\n";
-   print_issues(out, issues, section_db, [](issue const & i) {return is_tentative(i.stat);} );
+   print_issues(out, issues, bodies_for(issues), [](issue const & i) {return is_tentative(i.stat);} );
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 
@@ -557,9 +595,10 @@ void report_generator::make_unresolved(std::span<const issue> issues, fs::path c
    assert(std::ranges::is_sorted(issues, {}, &issue::num));
 
    fs::path filename{path / "lwg-unresolved.html"};
-   std::ofstream out{filename};
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues)) {
+      return;
+   }
+   std::ostringstream out;
    print_file_header(out, "C++ Standard Library Unresolved Issues");
 //   print_paper_heading(out, "active", lwg_issues_xml);
 //   out << lwg_issues_xml.get_intro("active") << '\n';
@@ -567,8 +606,9 @@ void report_generator::make_unresolved(std::span<const issue> issues, fs::path c
 //   out << "<h2 id='Status'></a>Issue Status</h2>\n" << lwg_issues_xml.get_statuses() << '\n';
    out << "<p>" << build_timestamp << "</p>";
    out << "<h2>Unresolved Issues</h2>\n";
-   print_issues(out, issues, section_db, [](issue const & i) {return is_not_resolved(i.stat);} );
+   print_issues(out, issues, bodies_for(issues), [](issue const & i) {return is_not_resolved(i.stat);} );
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 void report_generator::make_immediate(std::span<const issue> issues, fs::path const & path) {
@@ -576,9 +616,10 @@ void report_generator::make_immediate(std::span<const issue> issues, fs::path co
    assert(std::ranges::is_sorted(issues, {}, &issue::num));
 
    fs::path filename{path / "lwg-immediate.html"};
-   std::ofstream out{filename};
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues)) {
+      return;
+   }
+   std::ostringstream out;
    print_file_header(out, "C++ Standard Library Issues Resolved Directly In [INSERT CURRENT MEETING HERE]");
 out << R"(<h1>C++ Standard Library Issues Resolved Directly In [INSERT CURRENT MEETING HERE]</h1>
 <table>
@@ -602,8 +643,9 @@ out << R"(<h1>C++ Standard Library Issues Resolved Directly In [INSERT CURRENT M
 </table>
 )";
    out << "<h2>Immediate Issues</h2>\n";
-   print_issues(out, issues, section_db, [](issue const & i) {return "Immediate" == i.stat;} );
+   print_issues(out, issues, bodies_for(issues), [](issue const & i) {return status::immediate == i.stat;} );
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 void report_generator::make_ready(std::span<const issue> issues, fs::path const & path) {
@@ -611,9 +653,10 @@ void report_generator::make_ready(std::span<const issue> issues, fs::path const
    assert(std::ranges::is_sorted(issues, {}, &issue::num));
 
    fs::path filename{path / "lwg-ready.html"};
-   std::ofstream out{filename};
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues)) {
+      return;
+   }
+   std::ostringstream out;
    print_file_header(out, "C++ Standard Library Issues to be moved in [INSERT CURRENT MEETING HERE]");
 out << R"(<h1>C++ Standard Library Issues to be moved in [INSERT CURRENT MEETING HERE]</h1>
 <table>
@@ -637,8 +680,9 @@ out << R"(<h1>C++ Standard Library Issues to be moved in [INSERT CURRENT MEETING
 </table>
 )";
    out << "<h2>Ready Issues</h2>\n";
-   print_issues(out, issues, section_db, [](issue const & i) {return "Ready" == i.stat || "Tentatively Ready" == i.stat;} );
+   print_issues(out, issues, bodies_for(issues), [](issue const & i) {return status::ready == i.stat || status::tentatively_ready == i.stat;} );
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 void report_generator::make_editors_issues(std::span<const issue> issues, fs::path const & path) {
@@ -646,22 +690,25 @@ void report_generator::make_editors_issues(std::span<const issue> issues, fs::pa
    assert(std::ranges::is_sorted(issues, {}, &issue::num));
 
    fs::path filename{path / "lwg-issues-for-editor.html"};
-   std::ofstream out{filename};
-   if (!out) {
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues)) {
+      return;
    }
+   std::ostringstream out;
    print_file_header(out, "C++ Standard Library Issues Resolved Directly In [INSERT CURRENT MEETING HERE]");
    out << "<h1>C++ Standard Library Issues Resolved In [INSERT CURRENT MEETING HERE]</h1>\n";
-   print_resolutions(out, issues, section_db, [](issue const & i) {return "Pending WP" == i.stat;} );
+   print_resolutions(out, issues, sections, [](issue const & i) {return status::pending_wp == i.stat;} );
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
-void report_generator::make_sort_by_num(std::span<issue> issues, fs::path const & filename) {
+void report_generator::make_sort_by_num(std::span<issue_ref> issues, fs::path const & filename) {
    std::ranges::sort(issues, {}, &issue::num);
 
-   std::ofstream out{filename};
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues)) {
+      return;
+   }
+
+   std::ostringstream out;
    print_file_header(out, "LWG Table of Contents");
 
    out <<
@@ -673,8 +720,9 @@ R"(<h1>C++ Standard Library Issues List (Revision )" << lwg_issues_xml.get_revis
 )";
    out << "<p>" << build_timestamp << "</p>";
 
-   print_table(out, issues, section_db);
+   print_table(out, issues);
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 #ifndef __cpp_lib_ranges_chunk_by
@@ -688,7 +736,7 @@ auto chop(std::span<T>& s, std::size_t n)
 
 // Chop off and return  a subspan from the front of `issues`,
 // consisting of all values that are equivalent under `pred`.
-auto chunk_by(std::span<issue>& issues, auto pred) -> std::span<const issue> {
+auto chunk_by(std::span<issue_ref>& issues, auto pred) -> std::span<const issue_ref> {
    std::size_t n = 0;
    if (!issues.empty()) {
       auto end = std::ranges::find_if_not(issues, std::bind_front(pred, std::ref(issues.front())));
@@ -698,15 +746,17 @@ auto chunk_by(std::span<issue>& issues, auto pred) -> std::span<const issue> {
 }
 #endif
 
-void report_generator::make_sort_by_priority(std::span<issue> issues, fs::path const & filename) {
-   auto proj = [this](const auto& i) {
-      return std::tie(i.priority, section_db[i.tags.front()], i.num);
+void report_generator::make_sort_by_priority(std::span<issue_ref> issues, fs::path const & filename) {
+   auto proj = [this](const issue& i) {
+      return std::make_tuple(i.priority, sections.order(i.sections.front()), i.num);
    };
    std::ranges::sort(issues, {}, proj);
 
-   std::ofstream out{filename};
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues)) {
+      return;
+   }
+
+   std::ostringstream out;
    print_file_header(out, "LWG Table of Contents");
 
    out <<
@@ -719,7 +769,7 @@ sorted by priority.</p>
 )";
    out << "<p>" << build_timestamp << "</p>";
 
-//   print_table(out, issues, section_db);
+//   print_table(out, issues, sections);
 
    auto same_prio = [](const issue& lhs, const issue& rhs) {
      return lhs.priority == rhs.priority;
@@ -731,7 +781,7 @@ sorted by priority.</p>
        chunk = chunk_by(issues, same_prio))
 #endif
    {
-      const int px = chunk.front().priority;
+      const int px = chunk.front().get().priority;
       out << "<h2 id=\"Priority_" << px << "\">";
       if (px == 99) {
          out << "Not Prioritized";
@@ -740,16 +790,19 @@ sorted by priority.</p>
          out << "Priority " << px;
       }
       out << " (" << chunk.size() << " issues)</h2>\n";
-      print_table(out, chunk, section_db);
+      print_table(out, chunk);
    }
 
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
-void report_generator::make_sort_by_status_impl(std::span<issue> issues, fs::path const & filename, std::string title) {
-   std::ofstream out{filename};
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+void report_generator::make_sort_by_status_impl(std::span<issue_ref> issues, fs::path const & filename, std::string title) {
+   if (list_up_to_date(filename, issues, title)) {
+      return;
+   }
+
+   std::ostringstream out;
    print_file_header(out, "LWG Index by " + title, filename.filename().string(),
          "C++ standard library issues list");
 
@@ -775,63 +828,65 @@ This document is the Index by )" << title << R"( for the <a href="lwg-active.htm
        chunk = chunk_by(issues, same_status))
 #endif
    {
-      std::string current_status = chunk.front().stat;
-      auto idattr = spaces_to_underscores(current_status);
+      auto const current_status = chunk.front().get().stat;
+      auto idattr = spaces_to_underscores(std::string(as_string(current_status)));
       out << "<h2 id=\"" << idattr << "\">" << current_status
         << " (" << chunk.size() << " issues)</h2>\n";
-      print_table(out, chunk, section_db);
+      print_table(out, chunk);
    }
 
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 
-void report_generator::make_sort_by_status(std::span<issue> issues, fs::path const & filename) {
-   auto proj = [this](const auto& i) {
-      return std::make_tuple(lwg::get_status_priority(i.stat), ordered_section(section_db, i), ordered_date(i), i.num);
+void report_generator::make_sort_by_status(std::span<issue_ref> issues, fs::path const & filename) {
+   auto proj = [this](const issue& i) {
+      return std::make_tuple(i.stat, ordered_section(sections, i), ordered_date(i), i.num);
    };
    std::ranges::sort(issues, {}, proj);
    make_sort_by_status_impl(issues, filename, "Status and Section");
 }
 
 
-void report_generator::make_sort_by_status_mod_date(std::span<issue> issues, fs::path const & filename) {
-   auto proj = [this](const auto& i) {
-      return std::make_tuple(lwg::get_status_priority(i.stat), ordered_date(i), ordered_section(section_db, i), i.num);
+void report_generator::make_sort_by_status_mod_date(std::span<issue_ref> issues, fs::path const & filename) {
+   auto proj = [this](const issue& i) {
+      return std::make_tuple(i.stat, ordered_date(i), ordered_section(sections, i), i.num);
    };
    std::ranges::sort(issues, {}, proj);
    make_sort_by_status_impl(issues, filename, "Status and Date");
 }
 
 
-void report_generator::make_sort_by_section(std::span<issue> issues, fs::path const & filename, bool active_only) {
-   auto proj = [](const auto& i) {
-      return std::make_tuple(lwg::get_status_priority(i.stat), ordered_date(i), i.num);
+void report_generator::make_sort_by_section(std::span<issue_ref> issues, fs::path const & filename, bool active_only) {
+   auto proj = [](const issue& i) {
+      return std::make_tuple(i.stat, ordered_date(i), i.num);
    };
    std::ranges::sort(issues, {}, proj);
 
    if (active_only) {
-      auto status_priority = [](const issue& i) { return lwg::get_status_priority(i.stat); };
       // Find the first issue not in Voting, Immediate, or Ready status:
-      auto first = std::ranges::upper_bound(issues, lwg::get_status_priority("Ready"), {}, status_priority);
+      auto first = std::ranges::upper_bound(issues, status::ready, {}, &issue::stat);
       // Find the end of the active issues:
-      auto last = std::ranges::find_if_not(first, issues.end(), is_active, &issue::stat);
+      auto last = std::ranges::find_if_not(first, issues.end(), [](status s) { return is_active(s); }, &issue::stat);
       // Trim the span to only those active issues:
-      issues = std::span<issue>(first, last);
+      issues = std::span<issue_ref>(first, last);
    }
-   std::ranges::stable_sort(issues, order_by_section{section_db});
-   std::set<issue, order_by_major_section> mjr_section_open{order_by_major_section{section_db}};
+   std::ranges::stable_sort(issues, order_by_section{sections});
+   std::set<issue_ref, order_by_major_section> mjr_section_open{order_by_major_section{sections}};
    if (!active_only) {
-      for (auto const & elem : issues) {
+      for (issue const & elem : issues) {
          if (is_active_not_ready(elem.stat)) {
             mjr_section_open.insert(elem);
          }
       }
    }
 
-   std::ofstream out(filename);
-   if (!out)
-     throw std::runtime_error{"Failed to open " + filename.string()};
+   if (list_up_to_date(filename, issues, active_only ? "active only" : "")) {
+      return;
+   }
+
+   std::ostringstream out;
    print_file_header(out, "LWG Index by Section", filename.filename().string(),
          "C++ standard library issues list");
 
@@ -857,11 +912,11 @@ void report_generator::make_sort_by_section(std::span<issue> issues, fs::path co
    out << "<p>" << build_timestamp << "</p>";
 
    auto lookup_section = [this](const issue& i) {
-      return lookup_major_section(section_db, i);
+      return lookup_major_section(sections, i);
    };
 
-   auto same_section = [&](const issue& lhs, const issue& rhs) {
-     return lookup_section(lhs) == lookup_section(rhs);
+   auto same_section = [this](const issue& lhs, const issue& rhs) {
+     return ordered_major_section(sections, lhs) == ordered_major_section(sections, rhs);
    };
 #ifdef __cpp_lib_ranges_chunk_by
    for (auto chunk : issues | std::views::chunk_by(same_section))
@@ -882,38 +937,54 @@ void report_generator::make_sort_by_section(std::span<issue> issues, fs::path co
       else if (mjr_section_open.count(i) > 0) {
          out << "<p><a href=\"lwg-index-open.html#Section_" << idattr << "\">(view only non-Ready open issues)</a></p>\n";
       }
-      print_table(out, chunk, section_db, true);
+      print_table(out, chunk, true);
    }
 
    print_file_trailer(out);
+   write_page(filename, std::move(out).str());
 }
 
 // Create individual HTML files for each issue, to make linking to a single issue easier.
 void report_generator::make_individual_issues(std::span<const issue> issues, fs::path const & path) {
    assert(std::ranges::is_sorted(issues, {}, &issue::num));
-   issue_set_by_first_tag const  all_issues{ issues.begin(), issues.end()} ;
-   issue_set_by_status    const  issues_by_status{ issues.begin(), issues.end() };
+   auto const & counts = counts_for(issues);
+   auto const & bodies = bodies_for(issues);
 
-   issue_set_by_first_tag active_issues;
-   for (auto const & elem : issues) {
-      if (lwg::is_active(elem.stat)) {
-         active_issues.insert(elem);
-      }
-   }
-
-   for(auto & iss : issues){
+   page_writer writer{m_write_only_changed};
+   parallel_for(issues.size(), m_jobs, [&](std::size_t i) {
+      auto const & iss = issues[i];
       auto num = std::to_string(iss.num);
       fs::path filename{path / (num + ".html")};
-      std::ofstream out{filename};
-      if (!out)
-         throw std::runtime_error{"Failed to open " + filename.string()};
-      print_file_header(out, "Issue " + num + ": " + lwg::strip_xml_elements(iss.title),
-            // XXX should we use e.g. lwg-active.html#num as the canonical URL for the issue?
-            filename.filename().string(),
-            "C++ library issue. Status: " + iss.stat);
-      print_issue(out, iss, section_db, all_issues, issues_by_status, active_issues, print_issue_type::individual);
-      print_file_trailer(out);
-   }
+      if (m_manifest) {
+         // The page only depends on this issue, and which links to other issues it shows.
+         fingerprint inputs;
+         inputs.add(output_format_version).add(m_issue_inputs.at(iss.num));
+         inputs.add(counts.others_active_in_section(iss)).add(counts.others_in_section(iss)).add(counts.others_with_status(iss));
+         if (up_to_date(filename, inputs.value())) {
+            return;
+         }
+      }
+      trace_span span{"page", "issue page", iss.num};
+      auto const start = m_profile ? thread_cpu_time() : std::chrono::nanoseconds{};
+      auto page = format_issue_page(iss, bodies[i]);
+      if (m_profile) {
+         m_profile->add_render(iss.num, thread_cpu_time() - start, page.size());
+      }
+      writer.write(std::move(filename), std::move(page));
+   });
+   writer.finish();
+
+   m_issue_pages_written += writer.files_written();
+   m_issue_bytes_written += writer.bytes_written();
+   m_pages_unchanged += writer.files_unchanged();
+}
+
+void report_generator::render_issues(std::span<const issue> issues) {
+   bodies_for(issues);
+}
+
+auto report_generator::issue_page(std::span<const issue> issues, issue const & iss) -> std::string {
+   return format_issue_page(iss, render_issue_body(iss, sections, counts_for(issues)));
 }
 
 void report_generator::set_timestamp_from_issues(std::vector<issue> const & issues){
@@ -923,4 +994,165 @@ void report_generator::set_timestamp_from_issues(std::vector<issue> const & issu
    build_timestamp = oss.str();
 }
 
+void report_generator::track_pages(std::span<const issue> issues, page_manifest & manifest, bool incremental) {
+   m_manifest = &manifest;
+   m_incremental = incremental;
+   m_issue_inputs.clear();
+   for (auto const & iss : issues) {
+      m_issue_inputs[iss.num] = issue_inputs(iss, sections);
+   }
+   m_list_inputs = fingerprint{}
+      .add(output_format_version)
+      .add(build_date)
+      .add(build_timestamp)
+      .add(lwg_issues_xml.content_hash())
+      .value();
+}
+
+template <typename Issues>
+auto report_generator::list_up_to_date(fs::path const & filename, Issues const & issues, std::string_view extra_inputs) -> bool {
+   if (!m_manifest) {
+      return false;
+   }
+   // The lists that show issues in full pass every issue, not only the ones shown,
+   // because the "View other issues" links depend on the other issues too.
+   fingerprint inputs;
+   inputs.add(m_list_inputs).add(extra_inputs).add(std::ranges::size(issues));
+   for (issue const & iss : issues) {
+      inputs.add(m_issue_inputs.at(iss.num));
+   }
+   return up_to_date(filename, inputs.value());
+}
+
+void report_generator::count_issues(std::span<const issue> issues) {
+   if (!m_counts || m_counted.data() != issues.data() || m_counted.size() != issues.size()) {
+      m_counts.emplace(issues, sections);
+      m_counted = issues;
+      m_bodies.clear();
+   }
+}
+
+auto report_generator::counts_for(std::span<const issue> issues) -> issue_counts const & {
+   std::lock_guard lock{m_issues_mutex};
+   count_issues(issues);
+   return *m_counts;
+}
+
+auto report_generator::bodies_for(std::span<const issue> issues) -> std::vector<std::string> const & {
+   std::lock_guard lock{m_issues_mutex};
+   count_issues(issues);
+   if (m_bodies.size() != issues.size()) {
+      std::vector<std::string> bodies(issues.size());
+      parallel_for(issues.size(), m_jobs, [&](std::size_t i) {
+         auto const & iss = issues[i];
+         trace_span span{"render", "render_issue_body", iss.num};
+         auto const start = m_profile ? thread_cpu_time() : std::chrono::nanoseconds{};
+         bodies[i] = render_issue_body(iss, sections, *m_counts);
+         if (m_profile) {
+            m_profile->add_render(iss.num, thread_cpu_time() - start);
+         }
+      });
+      m_bodies = std::move(bodies);
+   }
+   return m_bodies;
+}
+
+auto report_generator::row_for(issue const & iss) -> table_row const & {
+   {
+      std::shared_lock lock{m_rows_mutex};
+      if (auto pos = m_rows.find(&iss); pos != m_rows.end()) {
+         return pos->second;
+      }
+   }
+   // Render without holding the lock. If another thread got there first, its row is used,
+   // which is the same. Elements of an unordered_map do not move when others are inserted.
+   auto row = render_table_row(iss, sections);
+   std::unique_lock lock{m_rows_mutex};
+   return m_rows.try_emplace(&iss, std::move(row)).first->second;
+}
+
+void report_generator::print_table(std::ostream& out, std::span<const issue_ref> issues, bool link_stable_names) {
+#if defined (DEBUG_LOGGING)
+   std::cout << "\t" << issues.size() << " items to add to table" << std::endl;
+#endif
+
+   out <<
+R"(<table class="issues-index">
+<tr>
+  <th><a href="lwg-toc.html">Issue</a></th>
+  <th><a href="lwg-status.html">Status</a></th>
+  <th><a href="lwg-index.html">Section</a></th>
+  <th>Title</th>
+  <th>Proposed Resolution</th>
+  <th><a href="unresolved-prioritized.html">Priority</a></th>
+  <th>Duplicates</th>
+</tr>
+)";
+
+   std::optional<section_id> prev_section;
+   for (issue const & i : issues) {
+      auto const & cached = row_for(i);
+      std::string_view row = cached.html;
+
+      // The first row for each section has an anchor for the section's stable name.
+      auto const section = i.sections[0];
+      if (link_stable_names && section != prev_section) {
+         prev_section = section;
+         auto const anchor_pos = cached.anchor_pos;
+         out << row.substr(0, anchor_pos)
+             << "<a id=\"" << as_string(sections.tag(section)) << "\"></a>"
+             << row.substr(anchor_pos);
+      }
+      else {
+         out << row;
+      }
+   }
+   out << "</table>\n";
+}
+
+void report_generator::write_page(fs::path const & filename, std::string contents) {
+   if (m_page_sink) {
+      m_page_sink(filename, std::move(contents));
+      return;
+   }
+   if (m_write_only_changed) {
+      // The date of the build, in the heading of the 3 standard lists, and of the latest change to
+      // any issue, in the "Revised" line of every list, would otherwise rewrite every page in every run.
+      // Only those lines are compared loosely, not the same dates elsewhere in the page.
+      auto const revised = std::string_view(build_timestamp).substr(0, build_timestamp.find('\n')).substr(std::string_view("Revised ").size());
+      volatile_line const volatile_lines[] = {
+         { R"(  <td align="left">)", build_date, "</td>" },
+         { "<p>Revised ", revised, "" },
+         { R"(<td align="left">Revised )", revised, "" },
+      };
+      if (page_unchanged(filename, contents, volatile_lines)) {
+         ++m_pages_unchanged;
+         return;
+      }
+   }
+   std::ofstream out{filename};
+   if (!out)
+     throw std::runtime_error{"Failed to open " + filename.string()};
+   out << contents;
+
+   std::lock_guard lock{m_written_mutex};
+   m_bytes_written[filename.string()] = contents.size();
+}
+
+auto report_generator::bytes_written(fs::path const & filename) const -> std::uintmax_t {
+   std::lock_guard lock{m_written_mutex};
+   auto i = m_bytes_written.find(filename.string());
+   return i == m_bytes_written.end() ? 0 : i->second;
+}
+
+auto report_generator::up_to_date(fs::path const & filename, std::uint64_t inputs) -> bool {
+   std::lock_guard lock{m_manifest_mutex};
+   bool unchanged = m_manifest->update(filename.filename().string(), inputs);
+   if (m_incremental && unchanged && fs::exists(filename)) {
+      ++m_pages_skipped;
+      return true;
+   }
+   return false;
+}
+
 } // close namespace lwg
@@ -1,11 +1,22 @@
 #ifndef INCLUDE_LWG_REPORT_GENERATOR_H
 #define INCLUDE_LWG_REPORT_GENERATOR_H
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <span>
 #include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
-#include "issues.h"  // cannot forward declare the 'section_map' alias, nor the 'LwgIssuesXml' alias
+#include "issues.h"  // cannot forward declare the 'section_id' alias, nor the 'LwgIssuesXml' alias
 
 namespace fs = std::filesystem;
 
@@ -13,15 +24,47 @@ namespace lwg
 {
 struct issue;
 struct mailing_info;
+struct page_manifest;
+struct issue_profile;
+
+
+struct issue_counts {
+   // The number of issues in each section and with each status, which decide whether an
+   // issue shows the "View other issues" links. Only the first section of an issue counts.
+
+   issue_counts(std::span<const issue> issues, section_registry const & sections);
+
+   auto others_in_section(issue const & iss) const -> bool { return in_section[iss.sections.front()] > 1; }
+   auto others_active_in_section(issue const & iss) const -> bool { return active_in_section[iss.sections.front()] > 1; }
+   auto others_with_status(issue const & iss) const -> bool { return with_status[static_cast<std::size_t>(iss.stat)] > 1; }
+
+private:
+   std::vector<unsigned>                  in_section;         // indexed by section_id
+   std::vector<unsigned>                  active_in_section;  // indexed by section_id
+   std::array<unsigned, status_count>     with_status{};      // indexed by status
+};
+
+
+struct table_row {
+   // The row of an index table for an issue, which is the same in every table.
+   // The tables indexed by section insert an anchor at 'anchor_pos' in the first row for each section.
+   std::string html;
+   std::size_t anchor_pos = 0;
+};
 
 
 struct report_generator {
 
-   report_generator(mailing_info const & info, section_map & sections)
+   report_generator(mailing_info const & info, section_registry const & sections, unsigned jobs = 1)
       : lwg_issues_xml(info)
-      , section_db(sections)
+      , sections(sections)
+      , m_jobs(jobs)
    {
    }
+      // Documents that consist of many pages are formatted by up to 'jobs' threads.
+
+   // The functions that make documents may be called concurrently, to make different documents.
+   // Those that take a 'std::span<const issue>' must all be passed the same complete list of issues.
 
    // Functions to make the 3 standard published issues list documents
    // A precondition for calling any of these functions is that the list of issues is sorted in numerical order, by issue number.
@@ -47,27 +90,125 @@ struct report_generator {
    void make_ready(std::span<const issue> issues, fs::path const & path);
       // publish a document listing all ready issues for a formal vote
 
-   void make_sort_by_num(std::span<issue> issues, fs::path const & filename);
+   // The index documents re-sort 'issues' for their own purposes, which only moves the handles.
+   void make_sort_by_num(std::span<issue_ref> issues, fs::path const & filename);
 
-   void make_sort_by_priority(std::span<issue> issues, fs::path const & filename);
+   void make_sort_by_priority(std::span<issue_ref> issues, fs::path const & filename);
 
-   void make_sort_by_status(std::span<issue> issues, fs::path const & filename);
+   void make_sort_by_status(std::span<issue_ref> issues, fs::path const & filename);
 
-   void make_sort_by_status_mod_date(std::span<issue> issues, fs::path const & filename);
+   void make_sort_by_status_mod_date(std::span<issue_ref> issues, fs::path const & filename);
 
-   void make_sort_by_section(std::span<issue> issues, fs::path const & filename, bool active_only = false);
+   void make_sort_by_section(std::span<issue_ref> issues, fs::path const & filename, bool active_only = false);
 
    void make_editors_issues(std::span<const issue> issues, fs::path const & path);
 
    void make_individual_issues(std::span<const issue> issues, fs::path const & path);
+      // Each page is formatted in memory, and written by a single write on a separate thread.
+
+   void render_issues(std::span<const issue> issues);
+      // Render the HTML of every issue that the documents showing issues in full share, using up
+      // to 'jobs' threads, so that the documents made afterwards only copy it. Otherwise the first
+      // such document renders every issue, one after another, while the others wait for it.
+
+   auto issue_page(std::span<const issue> issues, issue const & iss) -> std::string;
+      // The individual page for 'iss', one of 'issues', formatted without rendering any
+      // other issue or writing anything, e.g. to preview a single issue.
 
    static void set_timestamp_from_issues(std::vector<issue> const & issues);
 
+   void track_pages(std::span<const issue> issues, page_manifest & manifest, bool incremental);
+      // Record the inputs of every page made from now on in 'manifest'.
+      // If 'incremental' is true, a page is not written again if its inputs are the same as when
+      // the manifest was saved and the file still exists.
+      // The 'issues' must be the complete, formatted list of issues, and the timestamp must
+      // already have been set.
+
+   void send_pages_to(std::function<void(fs::path const &, std::string)> sink) { m_page_sink = std::move(sink); }
+      // Give every page that a make_* function makes to 'sink', instead of writing it to the
+      // file it is named after. Does not apply to 'make_individual_issues', see 'issue_page'.
+
+   void profile_issues(issue_profile & profile) { m_profile = &profile; }
+      // Add the time taken to render each issue, and the size of its own page, to 'profile'.
+
+   void write_only_changed_pages(bool enable) { m_write_only_changed = enable; }
+      // If 'enable' is true, a page is not written if the existing file already has the same
+      // contents, apart from the build date and the "Revised" timestamp, so that the file and
+      // its modification time are left alone.
+
+   auto pages_unchanged() const noexcept -> std::size_t { return m_pages_unchanged; }
+      // The number of pages that were not written because the existing file was the same.
+
+   auto pages_skipped() const noexcept -> std::size_t { return m_pages_skipped; }
+      // The number of pages that were not written because they were up to date.
+
+   auto issue_pages_written() const noexcept -> std::size_t { return m_issue_pages_written; }
+   auto issue_bytes_written() const noexcept -> std::uintmax_t { return m_issue_bytes_written; }
+      // The number of individual issue pages written by 'make_individual_issues', and their total size.
+
+   auto bytes_written(fs::path const & filename) const -> std::uintmax_t;
+      // The size of the page 'filename' if it was written, otherwise zero.
+
 private:
-   void make_sort_by_status_impl(std::span<issue> issues, fs::path const & filename, std::string title);
+   void make_sort_by_status_impl(std::span<issue_ref> issues, fs::path const & filename, std::string title);
+
+   template <typename Issues>
+   auto list_up_to_date(fs::path const & filename, Issues const & issues, std::string_view extra_inputs = {}) -> bool;
+      // Return true if the list 'filename' does not need to be written. Its inputs are the issues
+      // in 'issues' (a range of issue or issue_ref) in their current order, 'extra_inputs', and the
+      // inputs common to all lists.
+
+   void write_page(fs::path const & filename, std::string contents);
+      // Write 'contents' to 'filename', unless only changed pages are written and it is unchanged.
+
+   auto up_to_date(fs::path const & filename, std::uint64_t inputs) -> bool;
+      // Record the 'inputs' for 'filename', and return true if it does not need to be written.
+
+   void print_table(std::ostream & out, std::span<const issue_ref> issues, bool link_stable_names = false);
+      // Print the index table of 'issues'.
+
+   auto row_for(issue const & iss) -> table_row const &;
+      // The table row for 'iss', which is only rendered the first time.
+
+   auto counts_for(std::span<const issue> issues) -> issue_counts const &;
+      // The counts for 'issues', which every caller passes as the complete list of issues,
+      // so they are only counted once.
+
+   auto bodies_for(std::span<const issue> issues) -> std::vector<std::string> const &;
+      // The HTML for each issue in 'issues' after its number, which is the same in every
+      // document that shows the issue in full. Rendered once, like the counts, see 'render_issues'.
+
+   void count_issues(std::span<const issue> issues);
+      // Make 'm_counts' the counts for 'issues', if it is not already. The caller must hold 'm_issues_mutex'.
+
+   mailing_info const &     lwg_issues_xml;
+   section_registry const & sections;
+   unsigned const           m_jobs;
+
+   std::size_t          m_issue_pages_written = 0;
+   std::uintmax_t       m_issue_bytes_written = 0;
+   bool                 m_write_only_changed = false;
+   std::atomic<std::size_t> m_pages_unchanged = 0;
+   mutable std::mutex   m_written_mutex;
+   std::unordered_map<std::string, std::uintmax_t> m_bytes_written;  // of each page written by 'write_page'
+
+   issue_profile *      m_profile = nullptr;
+   std::function<void(fs::path const &, std::string)> m_page_sink;
+   page_manifest *      m_manifest = nullptr;
+   bool                 m_incremental = false;
+   std::size_t          m_pages_skipped = 0;
+   std::uint64_t        m_list_inputs = 0;
+   std::unordered_map<int, std::uint64_t> m_issue_inputs;
+
+   std::mutex                  m_manifest_mutex;  // guards m_manifest and m_pages_skipped while making documents
+
+   std::mutex                  m_issues_mutex;    // guards the following three
+   std::optional<issue_counts> m_counts;
+   std::span<const issue>      m_counted;
+   std::vector<std::string>    m_bodies;   // parallel to m_counted, see bodies_for
 
-   mailing_info const & lwg_issues_xml;
-   section_map &        section_db;
+   std::shared_mutex           m_rows_mutex;
+   std::unordered_map<issue const *, table_row> m_rows;
 };
 
 } // close namespace lwg
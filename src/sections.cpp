@@ -1,6 +1,9 @@
 #include "sections.h"
 
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <numeric>
 #include <sstream>
 #include <iostream>
 #include <cctype>
@@ -81,12 +84,16 @@ auto lwg::operator << (std::ostream& os, section_num const & sn) -> std::ostream
    return os;
 }
 
-auto lwg::read_section_db(std::istream & infile) -> section_map {
+auto lwg::read_section_db(std::string_view data) -> section_map {
    section_map section_db;
-   while (infile) {
-      ws(infile);
-      std::string line;
-      getline(infile, line);
+   while (!data.empty()) {
+      auto eol = data.find('\n');
+      std::string_view line = data.substr(0, eol);
+      data.remove_prefix(eol == data.npos ? data.size() : eol + 1);
+
+      // skip leading whitespace, and blank lines
+      while (!line.empty() && std::isspace(static_cast<unsigned char>(line.front())))
+        line.remove_prefix(1);
       if (!line.empty()) {
          // get [x.x....] symbolic tag
          assert(line.back() == ']');
@@ -99,40 +106,36 @@ auto lwg::read_section_db(std::istream & infile) -> section_map {
          assert(tag.name[tag.name.size()-1] == ']');
          tag.name.erase(0, 1);  // erase '[' from name
          tag.name.erase(tag.name.size() - 1);  // erase ']' from name
-         line.erase(p-1);    // remove symbolic tag from line
+         line = line.substr(0, p-1);    // remove symbolic tag from line
 
          // get the prefix if any
          section_num num;
-         while (!line.empty() && std::isspace(line[0]))
-           line.erase(0,1);
-         if (line.size() > 1 && std::isalpha(line[0])
+         if (line.size() > 1 && std::isalpha(static_cast<unsigned char>(line[0]))
            && line[1] != ' ' && line[1] != '.') // not an annex
          {
-           std::string::size_type end;
-           if ((end = line.find(' ')) != std::string::npos) {
+           std::string_view::size_type end;
+           if ((end = line.find(' ')) != std::string_view::npos) {
              num.prefix = line.substr(0, end);  // save prefix
-             line.erase(0, end+1);  // remove prefix + trailing space
+             line.remove_prefix(end+1);  // remove prefix + trailing space
            }
          }
          tag.prefix = num.prefix;
 
          // save [n.n....] numeric tag
-         std::istringstream temp(line);
-         if (!std::isdigit(line[0])) {
-            char c;
-            temp >> c;
-            num.num.push_back(100 + c - 'A');
-            temp >> c;
+         if (!line.empty() && !std::isdigit(static_cast<unsigned char>(line[0]))) {
+            num.num.push_back(100 + line[0] - 'A');
+            line.remove_prefix(std::min<std::size_t>(2, line.size()));  // letter and '.'
          }
 
-         while (temp) {
+         while (!line.empty()) {
             int n;
-            temp >> n;
-            if (!temp.fail()) {
-               num.num.push_back(n);
-               char dot;
-               temp >> dot;
+            auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), n);
+            if (ec != std::errc{}) {
+               break;
             }
+            num.num.push_back(n);
+            line.remove_prefix(ptr - line.data());
+            line.remove_prefix(std::min<std::size_t>(1, line.size()));  // '.'
          }
 //         std::cout << "tag=\"" << tag.prefix << "\", \"" << tag.name << "\"\n";
 //         std::cout << "num=\"" << num.prefix << "\", \"" << num.num[0] << "\"\n";
@@ -142,9 +145,12 @@ auto lwg::read_section_db(std::istream & infile) -> section_map {
    return section_db;
 }
 
-auto lwg::format_section_tag_as_link(section_map & section_db, section_tag const & tag) -> std::string {
+auto lwg::format_section_tag_as_link(section_map const & section_db, section_tag const & tag) -> std::string {
+   static section_num const unknown{};
+   auto it = section_db.find(tag);
+   const auto& num = it == section_db.end() ? unknown : it->second;
+
    std::ostringstream o;
-   const auto& num = section_db[tag];
    o << num << ' ';
    std::string url;
    if  (!tag.prefix.empty()) {
@@ -176,3 +182,47 @@ auto lwg::format_section_tag_as_link(section_map & section_db, section_tag const
       o << "<a href=\"" << url << "\">" << tag << "</a>";
    return o.str();
 }
+
+lwg::section_registry::section_registry(section_map const & section_db) {
+   m_sections.reserve(section_db.size());
+   for (auto const & [tag, num] : section_db) {
+      m_sections.push_back({tag, num, 0, 0, format_section_tag_as_link(section_db, tag)});
+   }
+
+   // Give each entry the rank of 'key(entry)' among all the entries.
+   auto rank = [this](auto key, std::uint32_t entry::* rank) {
+      std::vector<std::uint32_t> by_key(m_sections.size());
+      std::iota(by_key.begin(), by_key.end(), 0u);
+      std::ranges::stable_sort(by_key, {}, [&](auto i) { return key(m_sections[i]); });
+      std::uint32_t r = 0;
+      for (std::size_t i = 0; i != by_key.size(); ++i) {
+         if (i != 0 && key(m_sections[by_key[i-1]]) != key(m_sections[by_key[i]])) {
+            ++r;
+         }
+         m_sections[by_key[i]].*rank = r;
+      }
+   };
+   rank([](entry const & e) -> section_num const & { return e.num; }, &entry::order);
+   rank([](entry const & e) {
+      return std::pair<std::string_view, int>{e.num.prefix, e.num.num.empty() ? 0 : e.num.num.front()};
+   }, &entry::major_order);
+}
+
+auto lwg::section_registry::find(section_tag const & tag) const -> std::optional<section_id> {
+   auto it = std::ranges::lower_bound(m_sections, tag, {}, &entry::tag);
+   if (it != m_sections.end() && it->tag == tag) {
+      return static_cast<section_id>(it - m_sections.begin());
+   }
+   return std::nullopt;
+}
+
+void lwg::section_registry::append_link(std::string & out, section_tag const & tag) const {
+   if (auto id = find(tag)) {
+      out += link(*id);
+   }
+   else {
+      // References to unknown sections are rare, so are not worth caching.
+      static section_map const empty;
+      out += format_section_tag_as_link(empty, tag);
+   }
+}
@@ -1,9 +1,12 @@
 #ifndef INCLUDE_LWG_SECTIONS_H
 #define INCLUDE_LWG_SECTIONS_H
 
+#include <cstdint>
 #include <iosfwd>
 #include <map>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace lwg
@@ -32,12 +35,68 @@ std::string as_string(section_tag const & x); // without square brackets
 auto operator >> (std::istream & is, section_num & sn) -> std::istream &;
 auto operator << (std::ostream & os, section_num const & sn) -> std::ostream &;
 
-auto read_section_db(std::istream & stream) -> section_map;
+auto read_section_db(std::string_view data) -> section_map;
    // Read the current C++ standard tag -> section number index
-   // from the specified 'stream', and return it as a new
+   // from the specified 'data', and return it as a new
    // 'section_map' object.
 
-auto format_section_tag_as_link(section_map & section_db, section_tag const & tag) -> std::string;
+auto format_section_tag_as_link(section_map const & section_db, section_tag const & tag) -> std::string;
+   // Return the HTML for a reference to 'tag', e.g. "23.2.1 <a href="...">[tag]</a>".
+   // A tag that is not in 'section_db' is shown without a section number.
+   // Prefer 'section_registry::link' when formatting many references.
+
+using section_id = std::uint32_t;
+
+struct section_registry {
+   // A flat, immutable copy of a 'section_map' in which each section has a dense id.
+   //
+   // Ids are assigned in order of 'section_tag', so comparing two ids gives the same result
+   // as comparing their tags. Each section number is also given a rank among all the section
+   // numbers, so that comparing ranks gives the same result as comparing 'section_num's.
+   // This lets issues be sorted by section with integer comparisons.
+   //
+   // The HTML for a reference to each section is rendered once, at construction.
+   // Nothing is modified after construction, so it is safe to use concurrently.
+
+   explicit section_registry(section_map const & section_db);
+
+   auto find(section_tag const & tag) const -> std::optional<section_id>;
+      // Return the id of 'tag', or nullopt if it is not a known section.
+
+   auto size() const noexcept -> std::size_t { return m_sections.size(); }
+      // The number of sections. Every id is less than this.
+
+   auto tag(section_id id) const -> section_tag const & { return m_sections[id].tag; }
+   auto num(section_id id) const -> section_num const & { return m_sections[id].num; }
+
+   auto order(section_id id) const -> std::uint32_t { return m_sections[id].order; }
+      // The rank of this section number, e.g. 23.2.1 is ordered before 23.10.
+
+   auto order_by_num_then_tag(section_id id) const -> std::uint64_t {
+      // Distinguish sections with the same number, such as the 99 used for unknown sections.
+      return std::uint64_t{m_sections[id].order} << 32 | id;
+   }
+
+   auto major_order(section_id id) const -> std::uint32_t { return m_sections[id].major_order; }
+      // The rank of the prefix and first number of this section number, i.e. its Clause.
+
+   auto link(section_id id) const -> std::string const & { return m_sections[id].link; }
+      // The result of 'format_section_tag_as_link' for this section.
+
+   void append_link(std::string & out, section_tag const & tag) const;
+      // Append the HTML for a reference to 'tag' to 'out', which need not be a known section.
+
+private:
+   struct entry {
+      section_tag   tag;
+      section_num   num;
+      std::uint32_t order;
+      std::uint32_t major_order;
+      std::string   link;
+   };
+
+   std::vector<entry> m_sections; // sorted by tag, indexed by section_id
+};
 
 } // close namespace lwg
 
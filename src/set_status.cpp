@@ -23,6 +23,7 @@ namespace fs = std::filesystem;
 // solution specific headers
 //#include "issues.h"
 //#include "sections.h"
+#include "mapped_file.h"
 #include "status.h"
 
 struct bad_issue_file : std::runtime_error {
@@ -33,19 +34,6 @@ struct bad_issue_file : std::runtime_error {
 };
 
 
-auto read_file_into_string(fs::path const & filename) -> std::string {
-   // read a text file completely into memory, and return its contents as
-   // a 'string' for further manipulation.
-
-   std::ifstream infile{filename};
-   if (!infile.is_open()) {
-      throw std::runtime_error{"Unable to open file " + filename.string()};
-   }
-
-   std::istreambuf_iterator<char> first{infile}, last{};
-   return std::string {first, last};
-}
-
 // ============================================================================================================
 
 void check_is_directory(fs::path const & directory) {
@@ -82,7 +70,8 @@ int main(int argc, char const * argv[]) {
       std::string issue_file = std::string{"issue"} + argv[1] + ".xml";
       auto const filename = path / "xml" / issue_file;
 
-      auto issue_data = read_file_into_string(filename);
+      // Take a copy, because the file is rewritten below.
+      auto issue_data = lwg::read_file_into_string(filename);
 
       // find 'status' tag and replace it
       auto k = issue_data.find("<issue num=\"");
@@ -9,95 +9,191 @@
 #include <stdexcept>
 #include <iostream>  // eases debugging
 #include <algorithm>
+#include <array>
 
 namespace {
 constexpr std::string_view LWG_ACTIVE {"lwg-active.html" };
 constexpr std::string_view LWG_CLOSED {"lwg-closed.html" };
 constexpr std::string_view LWG_DEFECTS{"lwg-defects.html"};
+
+// Classification flags for each status
+namespace flag {
+enum : unsigned {
+   tentative     = 1u << 0,
+   not_resolved  = 1u << 1,  // still needs to be looked at by LWG
+   another_group = 1u << 2,  // assigned to another group, which implies 'not_resolved'
+   votable       = 1u << 3,
+   ready         = 1u << 4,
+};
+}
+
+struct status_info {
+   lwg::status      stat;
+   std::string_view name;
+   std::string_view base;      // 'name' without any "Pending" or "Tentatively" qualifier
+   std::string_view filename;  // the list that the issue appears in
+   unsigned         flags;
+};
+
+using enum lwg::status;
+
+// Indexed by lwg::status. Tentative issues are always active, and pending issues
+// appear in the same list as the status they are pending.
+constexpr status_info statuses[] {
+   {voting,                    "Voting",                    "Voting",        LWG_ACTIVE,  flag::votable},
+   {tentatively_voting,        "Tentatively Voting",        "Voting",        LWG_ACTIVE,  flag::tentative | flag::votable},
+   {immediate,                 "Immediate",                 "Immediate",     LWG_ACTIVE,  flag::votable},
+   {ready,                     "Ready",                     "Ready",         LWG_ACTIVE,  flag::ready},
+   {tentatively_ready,         "Tentatively Ready",         "Ready",         LWG_ACTIVE,  flag::tentative | flag::ready},
+   {tentatively_nad_editorial, "Tentatively NAD Editorial", "NAD Editorial", LWG_ACTIVE,  flag::tentative},
+   {tentatively_nad_future,    "Tentatively NAD Future",    "NAD Future",    LWG_ACTIVE,  flag::tentative},
+   {tentatively_nad,           "Tentatively NAD",           "NAD",           LWG_ACTIVE,  flag::tentative},
+   {review,                    "Review",                    "Review",        LWG_ACTIVE,  flag::not_resolved},
+   {new_,                      "New",                       "New",           LWG_ACTIVE,  flag::not_resolved},
+   {open,                      "Open",                      "Open",          LWG_ACTIVE,  flag::not_resolved},
+   {lewg,                      "LEWG",                      "LEWG",          LWG_ACTIVE,  flag::not_resolved | flag::another_group},
+   {ewg,                       "EWG",                       "EWG",           LWG_ACTIVE,  flag::not_resolved | flag::another_group},
+   {core,                      "Core",                      "Core",          LWG_ACTIVE,  flag::not_resolved | flag::another_group},
+   {sg1,                       "SG1",                       "SG1",           LWG_ACTIVE,  flag::not_resolved | flag::another_group},
+   {sg9,                       "SG9",                       "SG9",           LWG_ACTIVE,  flag::not_resolved | flag::another_group},
+   {sg16,                      "SG16",                      "SG16",          LWG_ACTIVE,  flag::not_resolved | flag::another_group},
+   {deferred,                  "Deferred",                  "Deferred",      LWG_ACTIVE,  flag::not_resolved},
+   {tentatively_resolved,      "Tentatively Resolved",      "Resolved",      LWG_ACTIVE,  flag::tentative},
+   {pending_dr,                "Pending DR",                "DR",            LWG_DEFECTS, 0},
+   {pending_wp,                "Pending WP",                "WP",            LWG_DEFECTS, 0},
+   {pending_resolved,          "Pending Resolved",          "Resolved",      LWG_DEFECTS, 0},
+   {pending_nad_future,        "Pending NAD Future",        "NAD Future",    LWG_CLOSED,  0},
+   {pending_nad_editorial,     "Pending NAD Editorial",     "NAD Editorial", LWG_CLOSED,  0},
+   {pending_nad,               "Pending NAD",               "NAD",           LWG_CLOSED,  0},
+   {nad_future,                "NAD Future",                "NAD Future",    LWG_CLOSED,  0},
+   {dr,                        "DR",                        "DR",            LWG_DEFECTS, 0},
+   {wp,                        "WP",                        "WP",            LWG_DEFECTS, 0},
+   {cxx23,                     "C++23",                     "C++23",         LWG_DEFECTS, 0},
+   {cxx20,                     "C++20",                     "C++20",         LWG_DEFECTS, 0},
+   {cxx17,                     "C++17",                     "C++17",         LWG_DEFECTS, 0},
+   {cxx14,                     "C++14",                     "C++14",         LWG_DEFECTS, 0},
+   {cxx11,                     "C++11",                     "C++11",         LWG_DEFECTS, 0},
+   {cd1,                       "CD1",                       "CD1",           LWG_DEFECTS, 0},
+   {tc1,                       "TC1",                       "TC1",           LWG_DEFECTS, 0},
+   {resolved,                  "Resolved",                  "Resolved",      LWG_DEFECTS, 0},
+   {ts,                        "TS",                        "TS",            LWG_DEFECTS, 0},
+   {trdec,                     "TRDec",                     "TRDec",         LWG_DEFECTS, 0},
+   {nad_editorial,             "NAD Editorial",             "NAD Editorial", LWG_CLOSED,  0},
+   {nad,                       "NAD",                       "NAD",           LWG_CLOSED,  0},
+   {dup,                       "Dup",                       "Dup",           LWG_CLOSED,  0},
+   {nad_concepts,              "NAD Concepts",              "NAD Concepts",  LWG_CLOSED,  0},
+   {nad_arrays,                "NAD Arrays",                "NAD Arrays",    LWG_CLOSED,  0},
+};
+
+constexpr bool table_is_consistent() {
+   for (std::size_t i = 0; i != std::size(statuses); ++i) {
+      auto const & s = statuses[i];
+      if (static_cast<std::size_t>(s.stat) != i) return false;
+      if (s.name.starts_with("Tentatively") != bool(s.flags & flag::tentative)) return false;
+      if (not s.name.ends_with(s.base)) return false;
+   }
+   return std::size(statuses) == lwg::status_count;
 }
+static_assert(table_is_consistent(), "the status table must list every lwg::status in order");
 
-auto lwg::filename_for_status(std::string_view stat) -> std::string_view {
-   // Tentative issues are always active
-   if (is_tentative(stat)) {
-      return LWG_ACTIVE;
+constexpr auto info(lwg::status stat) noexcept -> status_info const & {
+   return statuses[static_cast<std::size_t>(stat)];
+}
+
+// Status names sorted for binary search
+constexpr auto statuses_by_name = [] {
+   std::array<status_info, std::size(statuses)> result{};
+   std::ranges::copy(statuses, result.begin());
+   std::ranges::sort(result, {}, &status_info::name);
+   return result;
+}();
+}
+
+auto lwg::find_status(std::string_view stat) noexcept -> std::optional<status> {
+   auto i = std::ranges::lower_bound(statuses_by_name, stat, {}, &status_info::name);
+   if (i == statuses_by_name.end() or i->name != stat) {
+      return std::nullopt;
    }
+   return i->stat;
+}
 
-   stat = remove_qualifier(stat);
-   return (stat == "TC1")           ? LWG_DEFECTS
-        : (stat == "CD1")           ? LWG_DEFECTS
-        : (stat == "TS")            ? LWG_DEFECTS
-        : (stat == "C++11")         ? LWG_DEFECTS
-        : (stat == "C++14")         ? LWG_DEFECTS
-        : (stat == "C++17")         ? LWG_DEFECTS
-        : (stat == "C++20")         ? LWG_DEFECTS
-        : (stat == "C++23")         ? LWG_DEFECTS
-        : (stat == "WP")            ? LWG_DEFECTS
-        : (stat == "Resolved")      ? LWG_DEFECTS
-        : (stat == "DR")            ? LWG_DEFECTS
-        : (stat == "TRDec")         ? LWG_DEFECTS
-        : (stat == "Dup")           ? LWG_CLOSED
-        : (stat == "NAD")           ? LWG_CLOSED
-        : (stat == "NAD Future")    ? LWG_CLOSED
-        : (stat == "NAD Editorial") ? LWG_CLOSED
-        : (stat == "NAD Concepts")  ? LWG_CLOSED
-        : (stat == "NAD Arrays")    ? LWG_CLOSED
-        : (stat == "Voting")        ? LWG_ACTIVE
-        : (stat == "Immediate")     ? LWG_ACTIVE
-        : (stat == "Ready")         ? LWG_ACTIVE
-        : (stat == "Review")        ? LWG_ACTIVE
-        : (stat == "New")           ? LWG_ACTIVE
-        : (stat == "Open")          ? LWG_ACTIVE
-        : (stat == "EWG")           ? LWG_ACTIVE
-        : (stat == "LEWG")          ? LWG_ACTIVE
-        : (stat == "Core")          ? LWG_ACTIVE
-        : (stat == "SG1")           ? LWG_ACTIVE
-        : (stat == "SG9")           ? LWG_ACTIVE
-        : (stat == "SG16")          ? LWG_ACTIVE
-        : (stat == "Deferred")      ? LWG_ACTIVE
-        : throw std::runtime_error("unknown status '" + std::string(stat) + "'");
+auto lwg::parse_status(std::string_view stat) -> status {
+   if (auto s = find_status(stat)) {
+      return *s;
+   }
+   throw std::runtime_error("unknown status '" + std::string(stat) + "'");
 }
 
-auto lwg::is_active(std::string_view stat) -> bool {
+auto lwg::as_string(status stat) noexcept -> std::string_view {
+   return info(stat).name;
+}
+
+auto lwg::operator<<(std::ostream & out, status stat) -> std::ostream & {
+   return out << as_string(stat);
+}
+
+auto lwg::filename_for_status(status stat) noexcept -> std::string_view {
+   return info(stat).filename;
+}
+
+auto lwg::filename_for_status(std::string_view stat) -> std::string_view {
+   return filename_for_status(parse_status(stat));
+}
+
+auto lwg::get_status_priority(std::string_view stat) noexcept -> std::ptrdiff_t {
+   if (auto s = find_status(stat)) {
+      return get_status_priority(*s);
+   }
+#if !defined(DEBUG_SUPPORT)
+   // Diagnose when unknown status strings are passed
+   std::cout << "Unknown status: " << stat << std::endl;
+#endif
+   return std::size(statuses);
+}
+
+auto lwg::is_active(status stat) noexcept -> bool {
    return filename_for_status(stat) == LWG_ACTIVE;
 }
 
-auto lwg::is_active_not_ready(std::string_view stat) -> bool {
-   return stat != "Ready" and is_active(stat);
+auto lwg::is_active_not_ready(status stat) noexcept -> bool {
+   return stat != status::ready and is_active(stat);
 }
 
-auto lwg::is_defect(std::string_view stat) -> bool {
+auto lwg::is_defect(status stat) noexcept -> bool {
    return filename_for_status(stat) == LWG_DEFECTS;
 }
 
-auto lwg::is_closed(std::string_view stat) -> bool {
+auto lwg::is_closed(status stat) noexcept -> bool {
    return filename_for_status(stat) == LWG_CLOSED;
 }
 
-auto lwg::is_tentative(std::string_view stat) -> bool {
-   return stat.starts_with("Tentatively");
+auto lwg::is_tentative(status stat) noexcept -> bool {
+   return info(stat).flags & flag::tentative;
 }
 
-auto lwg::is_assigned_to_another_group(std::string_view stat) -> bool {
-   for (auto s : {"Core", "EWG", "LEWG", "SG1", "SG9", "SG16" }) {
-     if (s == stat) return true;
-   }
-   return false;
+auto lwg::is_assigned_to_another_group(status stat) noexcept -> bool {
+   return info(stat).flags & flag::another_group;
 }
 
-auto lwg::is_not_resolved(std::string_view stat) -> bool {
-   if (is_assigned_to_another_group(stat)) return true;
-   for (auto s : {"Deferred", "New", "Open", "Review"}) { if (s == stat) return true; }
-   return false;
+auto lwg::is_not_resolved(status stat) noexcept -> bool {
+   return info(stat).flags & flag::not_resolved;
 }
 
-auto lwg::is_votable(std::string_view stat) -> bool {
-   stat = remove_tentatively(stat);
-   for (auto s : {"Immediate", "Voting"}) { if (s == stat) return true; }
-   return false;
+auto lwg::is_votable(status stat) noexcept -> bool {
+   return info(stat).flags & flag::votable;
 }
 
-auto lwg::is_ready(std::string_view stat) -> bool {
-   return "Ready" == remove_tentatively(stat);
+auto lwg::is_ready(status stat) noexcept -> bool {
+   return info(stat).flags & flag::ready;
+}
+
+auto lwg::is_active(std::string_view stat) -> bool {
+   return is_active(parse_status(stat));
+}
+
+auto lwg::is_assigned_to_another_group(std::string_view stat) -> bool {
+   auto s = find_status(stat);
+   return s and is_assigned_to_another_group(*s);
 }
 
 // Functions to "normalize" a status string
@@ -122,60 +218,6 @@ auto lwg::remove_qualifier(std::string_view stat) -> std::string_view {
    return remove_tentatively(remove_pending(stat));
 }
 
-auto lwg::get_status_priority(std::string_view stat) noexcept -> std::ptrdiff_t {
-   static std::string_view const status_priority[] {
-      "Voting",
-      "Tentatively Voting",
-      "Immediate",
-      "Ready",
-      "Tentatively Ready",
-      "Tentatively NAD Editorial",
-      "Tentatively NAD Future",
-      "Tentatively NAD",
-      "Review",
-      "New",
-      "Open",
-      "LEWG",
-      "EWG",
-      "Core",
-      "SG1",
-      "SG9",
-      "SG16",
-      "Deferred",
-      "Tentatively Resolved",
-      "Pending DR",
-      "Pending WP",
-      "Pending Resolved",
-      "Pending NAD Future",
-      "Pending NAD Editorial",
-      "Pending NAD",
-      "NAD Future",
-      "DR",
-      "WP",
-      "C++23",
-      "C++20",
-      "C++17",
-      "C++14",
-      "C++11",
-      "CD1",
-      "TC1",
-      "Resolved",
-      "TS",
-      "TRDec",
-      "NAD Editorial",
-      "NAD",
-      "Dup",
-      "NAD Concepts",
-      "NAD Arrays",
-   };
-
-
-   auto const i = std::ranges::find(status_priority, stat);
-#if !defined(DEBUG_SUPPORT)
-   // Diagnose when unknown status strings are passed
-   if (std::end(status_priority) == i) {
-      std::cout << "Unknown status: " << stat << std::endl;
-   }
-#endif
-   return i - std::begin(status_priority);
+auto lwg::remove_qualifier(status stat) noexcept -> std::string_view {
+   return info(stat).base;
 }
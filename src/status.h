@@ -4,27 +4,103 @@
 // standard headers
 #include <string_view>
 #include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
 
 namespace lwg
 {
+// Every status an issue may have.
+// The enumerators are declared in the order that issues are presented when sorted by status,
+// so comparing two 'status' values compares their priority.
+enum class status : std::uint8_t {
+   voting,
+   tentatively_voting,
+   immediate,
+   ready,
+   tentatively_ready,
+   tentatively_nad_editorial,
+   tentatively_nad_future,
+   tentatively_nad,
+   review,
+   new_,
+   open,
+   lewg,
+   ewg,
+   core,
+   sg1,
+   sg9,
+   sg16,
+   deferred,
+   tentatively_resolved,
+   pending_dr,
+   pending_wp,
+   pending_resolved,
+   pending_nad_future,
+   pending_nad_editorial,
+   pending_nad,
+   nad_future,
+   dr,
+   wp,
+   cxx23,
+   cxx20,
+   cxx17,
+   cxx14,
+   cxx11,
+   cd1,
+   tc1,
+   resolved,
+   ts,
+   trdec,
+   nad_editorial,
+   nad,
+   dup,
+   nad_concepts,
+   nad_arrays,
+};
+
+// The number of enumerators of 'status'
+constexpr std::size_t status_count = static_cast<std::size_t>(status::nad_arrays) + 1;
+
+auto find_status(std::string_view stat) noexcept -> std::optional<status>;
+   // The status named 'stat' (e.g. "Tentatively Ready"), or nullopt if it is not a known status.
+
+auto parse_status(std::string_view stat) -> status;
+   // As 'find_status', but throws std::runtime_error if 'stat' is not a known status.
+
+auto as_string(status stat) noexcept -> std::string_view;
+   // The name of the status as written in the issue files.
+
+auto operator<<(std::ostream & out, status stat) -> std::ostream &;
+
+auto filename_for_status(status stat) noexcept -> std::string_view;
 auto filename_for_status(std::string_view stat) -> std::string_view;
 
+constexpr auto get_status_priority(status stat) noexcept -> std::ptrdiff_t {
+   return static_cast<std::ptrdiff_t>(stat);
+}
 auto get_status_priority(std::string_view stat) noexcept -> std::ptrdiff_t;
+   // Unknown statuses sort after all known ones.
+
+auto is_active(status stat) noexcept -> bool;
+auto is_active_not_ready(status stat) noexcept -> bool;
+auto is_defect(status stat) noexcept -> bool;
+auto is_closed(status stat) noexcept -> bool;
+auto is_tentative(status stat) noexcept -> bool;
+auto is_not_resolved(status stat) noexcept -> bool;
+auto is_assigned_to_another_group(status stat) noexcept -> bool;
+auto is_votable(status stat) noexcept -> bool;
+auto is_ready(status stat) noexcept -> bool;
 
+// Classify status strings that may not have been parsed, e.g. from an older issues list
 auto is_active(std::string_view stat) -> bool;
-auto is_active_not_ready(std::string_view stat) -> bool;
-auto is_defect(std::string_view stat) -> bool;
-auto is_closed(std::string_view stat) -> bool;
-auto is_tentative(std::string_view stat) -> bool;
-auto is_not_resolved(std::string_view stat) -> bool;
 auto is_assigned_to_another_group(std::string_view stat) -> bool;
-auto is_votable(std::string_view stat) -> bool;
-auto is_ready(std::string_view stat) -> bool;
 
 // Functions to "normalize" a status string
 auto remove_pending(std::string_view stat) -> std::string_view;
 auto remove_tentatively(std::string_view stat) -> std::string_view;
 auto remove_qualifier(std::string_view stat) -> std::string_view;
+auto remove_qualifier(status stat) noexcept -> std::string_view;
 
 
 } // close namespace lwg
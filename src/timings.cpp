@@ -0,0 +1,188 @@
+#include "timings.h"
+#include "parallel.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <format>
+#include <ostream>
+#include <utility>
+
+namespace lwg
+{
+
+namespace
+{
+using seconds = std::chrono::duration<double>;
+
+auto cpu_seconds(std::clock_t cpu) -> double {
+   return static_cast<double>(cpu) / CLOCKS_PER_SEC;
+}
+
+auto cpu_seconds(std::chrono::nanoseconds cpu) -> double {
+   return seconds(cpu).count();
+}
+
+// Charges the threads started by the calling thread to 'account' while it exists.
+// Any account that was already current is charged for them too when it is restored.
+struct scoped_thread_account {
+   thread_account   account;
+   thread_account * outer = std::exchange(thread_account::current, &account);
+
+   ~scoped_thread_account() {
+      thread_account::current = outer;
+      if (outer) {
+         outer->cpu += account.cpu;
+         outer->allocations += account.allocations;
+         outer->bytes += account.bytes;
+      }
+   }
+
+   // What the threads started while this was current, that have finished, used.
+   auto cpu() const -> std::chrono::nanoseconds { return std::chrono::nanoseconds(account.cpu); }
+   auto allocated() const -> memory::usage { return {account.allocations, account.bytes}; }
+};
+
+auto megabytes(std::uintmax_t bytes) -> double {
+   return static_cast<double>(bytes) / (1024 * 1024);
+}
+
+// Items per second, or zero if the stage was too quick to measure.
+auto rate(double items, double wall) -> double {
+   return wall > 0 ? items / wall : 0;
+}
+
+auto json_string(std::string_view s) -> std::string {
+   std::string result = "\"";
+   for (char c : s) {
+      if (c == '"' || c == '\\') {
+         result += '\\';
+      }
+      result += c;
+   }
+   return result += '"';
+}
+} // close unnamed namespace
+
+stage_timer::stage_timer(bool enabled)
+   : m_enabled{enabled}
+   , m_start{clock::now()}
+   , m_start_cpu{std::clock()}
+   , m_start_allocated{memory::allocated()}
+   , m_started{std::chrono::system_clock::now()}
+{
+}
+
+auto stage_timer::timed(std::string stage, std::function<void()> f, std::function<stage_size()> size) -> std::function<void()> {
+   if (!m_enabled && !trace::enabled()) {
+      return f;
+   }
+   return [this, stage = std::move(stage), f = std::move(f), size = std::move(size)] {
+      trace_span span{"stage", stage};
+      if (!m_enabled) {
+         f();
+         return;
+      }
+      auto const start = clock::now();
+      std::chrono::nanoseconds cpu;
+      memory::usage allocated;
+      {
+         // What this thread, and any threads the stage starts to help it, used,
+         // but not other stages running at the same time.
+         scoped_thread_account helpers;
+         auto const start_cpu = thread_cpu_time();
+         auto const start_allocated = memory::thread_allocated();
+         f();
+         cpu = thread_cpu_time() - start_cpu + helpers.cpu();
+         allocated = memory::thread_allocated() - start_allocated + helpers.allocated();
+      }
+      auto const wall = clock::now() - start;
+      auto const processed = size ? size() : stage_size{};
+
+      std::lock_guard lock{m_mutex};
+      m_stages.push_back({stage, start, wall, cpu, processed, bool(size), allocated, memory::peak_rss()});
+   };
+}
+
+auto stage_timer::sorted_stages() const -> std::vector<stage> {
+   std::vector<stage> stages;
+   {
+      std::lock_guard lock{m_mutex};
+      stages = m_stages;
+   }
+   std::ranges::stable_sort(stages, {}, &stage::start);
+   return stages;
+}
+
+void stage_timer::print(std::ostream & out) const {
+   auto const stages = sorted_stages();
+
+   std::size_t width = 5;  // "total"
+   for (auto const & s : stages) {
+      width = std::max(width, s.name.size());
+   }
+
+   out << "Timings:\n"
+       << std::format("  {:<{}}  {:>9}  {:>9}  {:>10}  {:>12}\n", "stage", width, "wall (s)", "cpu (s)", "issues/s", "bytes");
+   for (auto const & s : stages) {
+      auto const wall = seconds(s.wall).count();
+      out << std::format("  {:<{}}  {:9.3f}  {:9.3f}", s.name, width, wall, cpu_seconds(s.cpu));
+      if (s.sized) {
+         out << std::format("  {:10.0f}  {:12}", rate(s.size.issues, wall), s.size.bytes);
+      }
+      out << '\n';
+   }
+   out << std::format("  {:<{}}  {:9.3f}  {:9.3f}\n", "total", width,
+                      seconds(clock::now() - m_start).count(), cpu_seconds(std::clock() - m_start_cpu));
+}
+
+void stage_timer::print_memory(std::ostream & out) const {
+   if (!memory::counting()) {
+      return;
+   }
+   auto const stages = sorted_stages();
+
+   std::size_t width = 5;  // "total"
+   for (auto const & s : stages) {
+      width = std::max(width, s.name.size());
+   }
+
+   out << "Memory:\n"
+       << std::format("  {:<{}}  {:>12}  {:>14}  {:>20}\n", "stage", width, "allocations", "allocated (MB)", "peak RSS so far (MB)");
+   for (auto const & s : stages) {
+      out << std::format("  {:<{}}  {:12}  {:14.1f}  {:20.1f}\n", s.name, width,
+                         s.allocated.allocations, megabytes(s.allocated.bytes), megabytes(s.peak_rss_so_far));
+   }
+   auto const total = memory::allocated() - m_start_allocated;
+   out << std::format("  {:<{}}  {:12}  {:14.1f}  {:20.1f}\n", "total", width,
+                      total.allocations, megabytes(total.bytes), megabytes(memory::peak_rss()));
+}
+
+void stage_timer::print_json(std::ostream & out) const {
+   auto const stages = sorted_stages();
+
+   out << "{\n"
+       << std::format("  \"started\": {},\n", std::chrono::duration_cast<std::chrono::seconds>(m_started.time_since_epoch()).count())
+       << "  \"stages\": [";
+   char const * sep = "\n";
+   for (auto const & s : stages) {
+      auto const wall = seconds(s.wall).count();
+      out << sep << std::format("    {{\"name\": {}, \"start\": {:.6f}, \"wall\": {:.6f}, \"cpu\": {:.6f}",
+                                json_string(s.name), seconds(s.start - m_start).count(), wall, cpu_seconds(s.cpu));
+      if (s.sized) {
+         out << std::format(", \"issues\": {}, \"issues_per_second\": {:.1f}, \"bytes\": {}",
+                            s.size.issues, rate(s.size.issues, wall), s.size.bytes);
+      }
+      if (memory::counting()) {
+         out << std::format(", \"allocations\": {}, \"allocated_bytes\": {}, \"peak_rss_so_far\": {}",
+                            s.allocated.allocations, s.allocated.bytes, s.peak_rss_so_far);
+      }
+      out << '}';
+      sep = ",\n";
+   }
+   out << "\n  ],\n"
+       << std::format("  \"total\": {{\"wall\": {:.6f}, \"cpu\": {:.6f}}}\n",
+                      seconds(clock::now() - m_start).count(), cpu_seconds(std::clock() - m_start_cpu))
+       << "}\n";
+}
+
+} // close namespace lwg
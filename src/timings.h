@@ -0,0 +1,78 @@
+#ifndef INCLUDE_LWG_TIMINGS_H
+#define INCLUDE_LWG_TIMINGS_H
+
+// solution specific headers
+#include "memory_profile.h"
+
+// standard headers
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lwg
+{
+
+// What a stage of a program worked on, to report its throughput.
+struct stage_size {
+   std::size_t    issues = 0;  // the number of issues it processed
+   std::uintmax_t bytes  = 0;  // the size of the output it produced
+};
+
+// Records how long each stage of a program takes, e.g. for 'lists --timings'.
+// Stages may run concurrently on different threads.
+// A disabled timer records nothing and does not wrap the stages at all.
+struct stage_timer {
+   using clock = std::chrono::steady_clock;
+
+   explicit stage_timer(bool enabled = false);
+
+   auto enabled() const noexcept -> bool { return m_enabled; }
+
+   auto timed(std::string stage, std::function<void()> f, std::function<stage_size()> size = {}) -> std::function<void()>;
+      // 'f', recording the time it takes under the name 'stage' each time it is called.
+      // If 'size' is given, it is called after 'f' to find out what 'f' processed.
+      // If tracing is on, each call is also a span in the trace.
+
+   void print(std::ostream & out) const;
+      // A table of the wall clock and CPU time, and the throughput, of each stage in the order
+      // that they started, and in total.
+
+   void print_memory(std::ostream & out) const;
+      // A table of the memory allocated by each stage, and the peak physical memory the whole
+      // process had used when the stage ended, if memory allocations are being counted.
+
+   void print_json(std::ostream & out) const;
+      // The same as 'print' and 'print_memory', as a JSON object.
+
+private:
+   struct stage {
+      std::string              name;
+      clock::time_point        start;
+      clock::duration          wall;
+      std::chrono::nanoseconds cpu;        // of the threads that ran the stage, not of other stages
+      stage_size               size;
+      bool                     sized;
+      memory::usage            allocated;  // by the threads that ran the stage, not by other stages
+      std::uintmax_t           peak_rss_so_far;  // of the whole process, not only of the stage
+   };
+
+   auto sorted_stages() const -> std::vector<stage>;
+
+   bool const                            m_enabled;
+   clock::time_point const               m_start;
+   std::clock_t const                    m_start_cpu;
+   memory::usage const                   m_start_allocated;
+   std::chrono::system_clock::time_point m_started;
+   mutable std::mutex                    m_mutex;
+   std::vector<stage>                    m_stages;
+};
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_TIMINGS_H
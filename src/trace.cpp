@@ -0,0 +1,91 @@
+#include "trace.h"
+
+#include <format>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace lwg
+{
+
+namespace
+{
+using clock = std::chrono::steady_clock;
+
+struct event {
+   char const *      category;
+   std::string       name;
+   std::int64_t      issue;
+   clock::time_point start;
+   clock::duration   duration;
+   int               thread;
+};
+
+std::mutex         events_mutex;
+std::vector<event> events;
+clock::time_point  trace_start;
+
+// Small thread numbers are easier to read in a trace viewer than system thread ids.
+// The first thread to record a span, normally the main thread, is number 1.
+auto thread_number() -> int {
+   static std::atomic<int> next{1};
+   thread_local int const number = next++;
+   return number;
+}
+
+auto json_string(std::string_view s) -> std::string {
+   std::string result = "\"";
+   for (char c : s) {
+      if (c == '"' || c == '\\') {
+         result += '\\';
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+         result += std::format("\\u{:04x}", c);
+      }
+      else {
+         result += c;
+      }
+   }
+   return result += '"';
+}
+
+auto microseconds(clock::duration d) -> long long {
+   return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+} // close unnamed namespace
+
+void trace::start() {
+   {
+      std::lock_guard lock{events_mutex};
+      events.clear();
+      trace_start = clock::now();
+   }
+   thread_number();
+   detail::on = true;
+}
+
+void trace::detail::record(char const * category, std::string name, std::int64_t issue,
+                           clock::time_point start, clock::time_point end) {
+   int const thread = thread_number();
+   std::lock_guard lock{events_mutex};
+   events.push_back({category, std::move(name), issue, start, end - start, thread});
+}
+
+void trace::write(std::ostream & out) {
+   std::lock_guard lock{events_mutex};
+   out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+   char const * sep = "\n";
+   for (auto const & e : events) {
+      out << sep << std::format("{{\"name\": {}, \"cat\": \"{}\", \"ph\": \"X\", \"ts\": {}, \"dur\": {}, \"pid\": 1, \"tid\": {}",
+                                json_string(e.name), e.category, microseconds(e.start - trace_start), microseconds(e.duration), e.thread);
+      if (e.issue >= 0) {
+         out << ", \"args\": {\"issue\": " << e.issue << '}';
+      }
+      out << '}';
+      sep = ",\n";
+   }
+   out << "\n]}\n";
+}
+
+} // close namespace lwg
@@ -0,0 +1,92 @@
+#ifndef INCLUDE_LWG_TRACE_H
+#define INCLUDE_LWG_TRACE_H
+
+// standard headers
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace lwg
+{
+
+// A trace of what a program did and when, on each thread, in the Trace Event Format
+// that chrome://tracing and Perfetto open.
+//
+// Tracing is off unless 'start' is called. While it is off, a 'trace_span' only tests a flag,
+// so spans can be placed in loops over every issue.
+namespace trace
+{
+
+namespace detail
+{
+inline std::atomic<bool> on{false};
+
+void record(char const * category, std::string name, std::int64_t issue,
+            std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+}
+
+void start();
+   // Record every span that ends from now on, discarding any spans recorded before, so that
+   // a program that does the same work repeatedly can write a trace of each time.
+
+inline auto enabled() noexcept -> bool {
+   return detail::on.load(std::memory_order_relaxed);
+}
+
+void write(std::ostream & out);
+   // Write the recorded spans as a JSON trace file.
+
+} // close namespace trace
+
+
+// Records the time from its construction to its destruction as a span in the trace, on
+// the current thread. The 'category' groups similar spans, e.g. "parse", and 'name'
+// says what the span worked on, e.g. a file name. A non-negative 'issue' number is shown
+// as an argument of the span, so that slow issues can be found.
+struct trace_span {
+   trace_span(char const * category, std::string_view name, std::int64_t issue = -1)
+      : m_category{category}
+   {
+      if (trace::enabled()) {
+         m_name = name;
+         m_issue = issue;
+         m_start = std::chrono::steady_clock::now();
+         m_active = true;
+      }
+   }
+
+   // As above, named after the file, which is only converted to a string if tracing is on.
+   template<std::same_as<std::filesystem::path> Path>
+   trace_span(char const * category, Path const & file)
+      : trace_span{category, std::string_view{}}
+   {
+      if (m_active) {
+         m_name = file.filename().string();
+      }
+   }
+
+   ~trace_span() {
+      if (m_active) {
+         trace::detail::record(m_category, std::move(m_name), m_issue, m_start, std::chrono::steady_clock::now());
+      }
+   }
+
+   trace_span(trace_span const &) = delete;
+   trace_span & operator=(trace_span const &) = delete;
+
+private:
+   char const *                          m_category;
+   bool                                  m_active = false;
+   std::string                           m_name;
+   std::int64_t                          m_issue = -1;
+   std::chrono::steady_clock::time_point m_start;
+};
+
+} // close namespace lwg
+
+#endif // INCLUDE_LWG_TRACE_H